@@ -0,0 +1,21 @@
+# Finds the brotli decoder and provides it as the imported target BrotliDec::BrotliDec.
+# Gets installed next to the cpr package config, so consumers of a static cpr find it on their own system.
+find_path(BROTLI_INCLUDE_DIR brotli/decode.h)
+find_library(BROTLIDEC_LIBRARY NAMES brotlidec brotlidec-static)
+find_library(BROTLICOMMON_LIBRARY NAMES brotlicommon brotlicommon-static)
+
+include(FindPackageHandleStandardArgs)
+find_package_handle_standard_args(BrotliDec DEFAULT_MSG BROTLIDEC_LIBRARY BROTLICOMMON_LIBRARY BROTLI_INCLUDE_DIR)
+
+if(BrotliDec_FOUND AND NOT TARGET BrotliDec::BrotliDec)
+    add_library(BrotliDec::BrotliCommon UNKNOWN IMPORTED)
+    set_target_properties(BrotliDec::BrotliCommon PROPERTIES
+        IMPORTED_LOCATION "${BROTLICOMMON_LIBRARY}")
+    add_library(BrotliDec::BrotliDec UNKNOWN IMPORTED)
+    set_target_properties(BrotliDec::BrotliDec PROPERTIES
+        IMPORTED_LOCATION "${BROTLIDEC_LIBRARY}"
+        INTERFACE_INCLUDE_DIRECTORIES "${BROTLI_INCLUDE_DIR}"
+        INTERFACE_LINK_LIBRARIES BrotliDec::BrotliCommon)
+endif()
+
+mark_as_advanced(BROTLI_INCLUDE_DIR BROTLIDEC_LIBRARY BROTLICOMMON_LIBRARY)
@@ -8,8 +8,37 @@
 #include <string>
 #include <utility>
 
+#include <curl/curl.h>
+
+#include "cpr/content_decoder.h"
+
 namespace cpr {
 
+namespace {
+bool isDecodedByCurl(const std::string& method) {
+    const curl_version_info_data* info = curl_version_info(CURLVERSION_NOW);
+    if (method == "gzip" || method == "deflate") {
+        return (info->features & CURL_VERSION_LIBZ) != 0;
+    }
+    if (method == "br") {
+#ifdef CURL_VERSION_BROTLI
+        return (info->features & CURL_VERSION_BROTLI) != 0;
+#else
+        return false;
+#endif
+    }
+    if (method == "zstd") {
+#ifdef CURL_VERSION_ZSTD
+        return (info->features & CURL_VERSION_ZSTD) != 0;
+#else
+        return false;
+#endif
+    }
+    // Passed on as they are, there is nothing cpr could do better here
+    return true;
+}
+} // namespace
+
 AcceptEncoding::AcceptEncoding(const std::initializer_list<AcceptEncodingMethods>& methods) {
     methods_.clear();
     std::transform(methods.begin(), methods.end(), std::inserter(methods_, methods_.begin()), [&](cpr::AcceptEncodingMethods method) { return cpr::AcceptEncodingMethodsStringMap.at(method); });
@@ -35,4 +64,12 @@ const std::string AcceptEncoding::getString() const {
     return false;
 }
 
+bool AcceptEncoding::requiresContentDecoder() const {
+    return std::any_of(methods_.begin(), methods_.end(), [](const std::string& method) {
+        // Ignore quality values like in "br;q=0.9"
+        const std::string name = method.substr(0, method.find(';'));
+        return !isDecodedByCurl(name) && util::ContentDecoder::IsSupported(name);
+    });
+}
+
 } // namespace cpr
@@ -0,0 +1,43 @@
+#include "cpr/buffer_pool.h"
+
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <utility>
+
+namespace cpr {
+BufferPool::BufferPool(size_t max_buffers, size_t max_capacity) : state_(std::make_shared<State>()) {
+    state_->max_buffers = max_buffers;
+    state_->max_capacity = max_capacity;
+    state_->buffers.reserve(max_buffers);
+}
+
+std::string BufferPool::Acquire() const {
+    const std::unique_lock lock(state_->mutex);
+    if (state_->buffers.empty()) {
+        return std::string{};
+    }
+    std::string buffer = std::move(state_->buffers.back());
+    state_->buffers.pop_back();
+    return buffer;
+}
+
+void BufferPool::Release(std::string&& buffer) const {
+    // Buffers using the small string optimization hold no heap memory worth keeping
+    if (buffer.capacity() <= std::string{}.capacity() || buffer.capacity() > state_->max_capacity) {
+        return;
+    }
+    buffer.clear();
+
+    const std::unique_lock lock(state_->mutex);
+    if (state_->buffers.size() < state_->max_buffers) {
+        state_->buffers.push_back(std::move(buffer));
+    }
+}
+
+size_t BufferPool::GetSize() const {
+    const std::unique_lock lock(state_->mutex);
+    return state_->buffers.size();
+}
+} // namespace cpr
@@ -0,0 +1,273 @@
+#include "cpr/content_decoder.h"
+
+#include <algorithm>
+#include <cctype>
+#include <climits>
+#include <cstdint>
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <utility>
+
+#include <curl/curl.h>
+
+#include "cpr/response_header.h"
+
+#ifdef CPR_ZLIB_SUPPORT
+#include <zlib.h>
+#endif
+#ifdef CPR_ZSTD_SUPPORT
+#include <zstd.h>
+#endif
+#ifdef CPR_BROTLI_SUPPORT
+#include <brotli/decode.h>
+#endif
+
+namespace cpr::util {
+
+class ContentDecoder::Decompressor {
+  public:
+    Decompressor() = default;
+    Decompressor(const Decompressor& other) = delete;
+    Decompressor(Decompressor&& old) = delete;
+    Decompressor& operator=(const Decompressor& other) = delete;
+    Decompressor& operator=(Decompressor&& old) = delete;
+    virtual ~Decompressor() = default;
+
+    /**
+     * Decompresses as much of input into output as fits.
+     * Consumed input gets removed from the front of input, output_size gets set to the number of bytes written to output.
+     * Returns false in case the data is invalid.
+     **/
+    virtual bool Decompress(std::string_view& input, char* output, size_t& output_size) = 0;
+};
+
+namespace {
+#ifdef CPR_ZLIB_SUPPORT
+class ZlibDecompressor : public ContentDecoder::Decompressor {
+  public:
+    ZlibDecompressor() {
+        // 32 added to the window bits detects the gzip and zlib format automatically
+        const int window_bits = 15 + 32;
+        initialized_ = inflateInit2(&stream_, window_bits) == Z_OK;
+    }
+    ZlibDecompressor(const ZlibDecompressor& other) = delete;
+    ZlibDecompressor(ZlibDecompressor&& old) = delete;
+    ZlibDecompressor& operator=(const ZlibDecompressor& other) = delete;
+    ZlibDecompressor& operator=(ZlibDecompressor&& old) = delete;
+    ~ZlibDecompressor() override {
+        if (initialized_) {
+            inflateEnd(&stream_);
+        }
+    }
+
+    bool Decompress(std::string_view& input, char* output, size_t& output_size) override {
+        if (!initialized_) {
+            return false;
+        }
+        if (finished_) {
+            // Ignore anything following the end of the stream, like curl does
+            input = {};
+            output_size = 0;
+            return true;
+        }
+        // zlib counts in 32 bit, so larger buffers get handled over multiple calls
+        const uInt input_size = static_cast<uInt>(std::min<size_t>(input.size(), UINT_MAX));
+        const uInt output_capacity = static_cast<uInt>(std::min<size_t>(output_size, UINT_MAX));
+        stream_.next_in = reinterpret_cast<Bytef*>(const_cast<char*>(input.data())); // NOLINT (cppcoreguidelines-pro-type-reinterpret-cast, cppcoreguidelines-pro-type-const-cast)
+        stream_.avail_in = input_size;
+        stream_.next_out = reinterpret_cast<Bytef*>(output); // NOLINT (cppcoreguidelines-pro-type-reinterpret-cast)
+        stream_.avail_out = output_capacity;
+        const int result = inflate(&stream_, Z_NO_FLUSH);
+        if (result != Z_OK && result != Z_STREAM_END && result != Z_BUF_ERROR) {
+            return false;
+        }
+        finished_ = result == Z_STREAM_END;
+        input.remove_prefix(input_size - stream_.avail_in);
+        output_size = output_capacity - stream_.avail_out;
+        return true;
+    }
+
+  private:
+    z_stream stream_{};
+    bool initialized_{false};
+    bool finished_{false};
+};
+#endif
+
+#ifdef CPR_ZSTD_SUPPORT
+class ZstdDecompressor : public ContentDecoder::Decompressor {
+  public:
+    ZstdDecompressor() = default;
+    ZstdDecompressor(const ZstdDecompressor& other) = delete;
+    ZstdDecompressor(ZstdDecompressor&& old) = delete;
+    ZstdDecompressor& operator=(const ZstdDecompressor& other) = delete;
+    ZstdDecompressor& operator=(ZstdDecompressor&& old) = delete;
+    ~ZstdDecompressor() override {
+        ZSTD_freeDCtx(context_);
+    }
+
+    bool Decompress(std::string_view& input, char* output, size_t& output_size) override {
+        if (!context_) {
+            return false;
+        }
+        ZSTD_inBuffer in{input.data(), input.size(), 0};
+        ZSTD_outBuffer out{output, output_size, 0};
+        if (ZSTD_isError(ZSTD_decompressStream(context_, &out, &in))) {
+            return false;
+        }
+        input.remove_prefix(in.pos);
+        output_size = out.pos;
+        return true;
+    }
+
+  private:
+    ZSTD_DCtx* context_{ZSTD_createDCtx()};
+};
+#endif
+
+#ifdef CPR_BROTLI_SUPPORT
+class BrotliDecompressor : public ContentDecoder::Decompressor {
+  public:
+    BrotliDecompressor() = default;
+    BrotliDecompressor(const BrotliDecompressor& other) = delete;
+    BrotliDecompressor(BrotliDecompressor&& old) = delete;
+    BrotliDecompressor& operator=(const BrotliDecompressor& other) = delete;
+    BrotliDecompressor& operator=(BrotliDecompressor&& old) = delete;
+    ~BrotliDecompressor() override {
+        BrotliDecoderDestroyInstance(state_);
+    }
+
+    bool Decompress(std::string_view& input, char* output, size_t& output_size) override {
+        if (!state_) {
+            return false;
+        }
+        size_t available_in = input.size();
+        const uint8_t* next_in = reinterpret_cast<const uint8_t*>(input.data()); // NOLINT (cppcoreguidelines-pro-type-reinterpret-cast)
+        size_t available_out = output_size;
+        uint8_t* next_out = reinterpret_cast<uint8_t*>(output); // NOLINT (cppcoreguidelines-pro-type-reinterpret-cast)
+        const BrotliDecoderResult result = BrotliDecoderDecompressStream(state_, &available_in, &next_in, &available_out, &next_out, nullptr);
+        if (result == BROTLI_DECODER_RESULT_ERROR) {
+            return false;
+        }
+        // Ignore anything following the end of the stream, like curl does
+        input.remove_prefix(result == BROTLI_DECODER_RESULT_SUCCESS ? input.size() : input.size() - available_in);
+        output_size -= available_out;
+        return true;
+    }
+
+  private:
+    BrotliDecoderState* state_{BrotliDecoderCreateInstance(nullptr, nullptr, nullptr)};
+};
+#endif
+
+std::unique_ptr<ContentDecoder::Decompressor> createDecompressor(std::string_view encoding) {
+#ifdef CPR_ZLIB_SUPPORT
+    if (encoding == "gzip" || encoding == "x-gzip" || encoding == "deflate") {
+        return std::make_unique<ZlibDecompressor>();
+    }
+#endif
+#ifdef CPR_ZSTD_SUPPORT
+    if (encoding == "zstd") {
+        return std::make_unique<ZstdDecompressor>();
+    }
+#endif
+#ifdef CPR_BROTLI_SUPPORT
+    if (encoding == "br") {
+        return std::make_unique<BrotliDecompressor>();
+    }
+#endif
+    static_cast<void>(encoding);
+    return nullptr;
+}
+
+std::string normalizeEncoding(std::string_view encoding) {
+    const size_t begin = encoding.find_first_not_of(" \t");
+    const size_t end = encoding.find_last_not_of(" \t");
+    std::string result{begin == std::string_view::npos ? std::string_view{} : encoding.substr(begin, end - begin + 1)};
+    std::transform(result.begin(), result.end(), result.begin(), [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+    return result;
+}
+
+std::string getContentEncoding(CURL* handle, const std::string* raw_header) {
+#if LIBCURL_VERSION_NUM >= 0x075400 // 7.84.0
+    // Also works in case the headers go to a HeaderCallback instead of the raw header
+    static_cast<void>(raw_header);
+    curl_header* header{nullptr};
+    if (curl_easy_header(handle, "Content-Encoding", 0, CURLH_HEADER, -1, &header) == CURLHE_OK) {
+        return header->value;
+    }
+    return {};
+#else
+    static_cast<void>(handle);
+    // Only the header of the last response (e.g. after redirects) belongs to the body
+    const std::string_view raw{*raw_header};
+    const size_t start = raw.rfind("\nHTTP/");
+    const ResponseHeader header{raw.substr(start == std::string_view::npos ? 0 : start + 1)};
+    return std::string{header["Content-Encoding"]};
+#endif
+}
+} // namespace
+
+ContentDecoder::ContentDecoder(CURL* handle, const std::string* raw_header, std::function<size_t(char* data, size_t size)> write) : handle_(handle), raw_header_(raw_header), write_(std::move(write)), buffer_(BUFFER_SIZE) {}
+
+ContentDecoder::ContentDecoder(std::string_view encoding, std::function<size_t(char* data, size_t size)> write) : write_(std::move(write)), buffer_(BUFFER_SIZE), started_(true) {
+    if (!selectDecompressor(encoding)) {
+        throw std::invalid_argument("Unsupported content encoding: " + std::string{encoding});
+    }
+}
+
+ContentDecoder::~ContentDecoder() = default;
+
+size_t ContentDecoder::Write(std::string_view data) {
+    if (!started_ && !begin()) {
+        return 0;
+    }
+    if (!decompressor_) {
+        // NOLINTNEXTLINE (cppcoreguidelines-pro-type-const-cast)
+        return write_(const_cast<char*>(data.data()), data.size()) == data.size() ? data.size() : 0;
+    }
+
+    std::string_view input = data;
+    while (true) {
+        const size_t remaining = input.size();
+        size_t size = buffer_.size();
+        if (!decompressor_->Decompress(input, buffer_.data(), size)) {
+            return 0;
+        }
+        if (size > 0 && write_(buffer_.data(), size) != size) {
+            return 0;
+        }
+        // A full buffer means there might be more output pending, even without any input left
+        if (size < buffer_.size() && (input.empty() || input.size() == remaining)) {
+            break;
+        }
+    }
+    return data.size();
+}
+
+bool ContentDecoder::IsSupported(std::string_view encoding) {
+    const std::string normalized = normalizeEncoding(encoding);
+    return normalized == "identity" || createDecompressor(normalized) != nullptr;
+}
+
+bool ContentDecoder::begin() {
+    started_ = true;
+    // All headers have been received once the body starts
+    return selectDecompressor(getContentEncoding(handle_, raw_header_));
+}
+
+bool ContentDecoder::selectDecompressor(std::string_view encoding) {
+    const std::string normalized = normalizeEncoding(encoding);
+    if (normalized.empty() || normalized == "identity") {
+        return true;
+    }
+    // Multiple encodings applied after each other are not supported
+    decompressor_ = createDecompressor(normalized);
+    return decompressor_ != nullptr;
+}
+
+} // namespace cpr::util
@@ -0,0 +1,125 @@
+#include "cpr/cookie_jar.h"
+
+#include <chrono>
+#include <ctime>
+#include <curl/curl.h>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+
+#include "cpr/connection_pool.h"
+#include "cpr/cookies.h"
+#include "cpr/curlholder.h"
+
+namespace cpr {
+namespace {
+void lockShare(CURL* /*handle*/, curl_lock_data /*data*/, curl_lock_access /*access*/, void* userptr) {
+    std::mutex* lock = static_cast<std::mutex*>(userptr);
+    lock->lock(); // cppcheck-suppress localMutex  // False positive: mutex is used as callback for libcurl, not local scope
+}
+
+void unlockShare(CURL* /*handle*/, curl_lock_data /*data*/, void* userptr) {
+    std::mutex* lock = static_cast<std::mutex*>(userptr);
+    lock->unlock();
+}
+
+bool containsLineBreakOrTab(const std::string& s) {
+    return s.find_first_of("\t\r\n") != std::string::npos;
+}
+
+/**
+ * Returns the cookie as a line of the Netscape cookie file format, as understood by CURLOPT_COOKIELIST.
+ **/
+std::string toNetscapeLine(const Cookie& cookie) {
+    const std::time_t expires = std::chrono::system_clock::to_time_t(cookie.GetExpires());
+    std::string line;
+    line.reserve(cookie.GetDomain().size() + cookie.GetPath().size() + cookie.GetName().size() + cookie.GetValue().size() + 40);
+    line += cookie.GetDomain();
+    line += cookie.IsIncludingSubdomains() ? "\tTRUE\t" : "\tFALSE\t";
+    line += cookie.GetPath().empty() ? "/" : cookie.GetPath();
+    line += cookie.IsHttpsOnly() ? "\tTRUE\t" : "\tFALSE\t";
+    // An expiry of 0 marks a session cookie
+    line += std::to_string(expires > 0 ? expires : 0);
+    line += '\t';
+    line += cookie.GetName();
+    line += '\t';
+    line += cookie.GetValue();
+    return line;
+}
+} // namespace
+
+CookieJar::CookieJar() : share_mutex_(std::make_shared<std::mutex>()), holder_mutex_(std::make_shared<std::mutex>()) {
+    CURLSH* curl_share = curl_share_init();
+    curl_share_setopt(curl_share, CURLSHOPT_SHARE, CURL_LOCK_DATA_COOKIE);
+    curl_share_setopt(curl_share, CURLSHOPT_USERDATA, share_mutex_.get());
+    curl_share_setopt(curl_share, CURLSHOPT_LOCKFUNC, lockShare);
+    curl_share_setopt(curl_share, CURLSHOPT_UNLOCKFUNC, unlockShare);
+
+    curl_sh_ = std::shared_ptr<CURLSH>(curl_share, [](CURLSH* ptr) {
+        // Make sure to reset callbacks before cleanup to avoid deadlocks
+        curl_share_setopt(ptr, CURLSHOPT_LOCKFUNC, nullptr);
+        curl_share_setopt(ptr, CURLSHOPT_UNLOCKFUNC, nullptr);
+        curl_share_cleanup(ptr);
+    });
+    holder_ = std::make_shared<CurlHolder>();
+    SetupHandler(holder_->handle);
+}
+
+CookieJar::CookieJar(const ConnectionPool& pool) : share_mutex_(pool.connection_mutex_), curl_sh_(pool.curl_sh_), holder_mutex_(std::make_shared<std::mutex>()) {
+    // Fails in case a handle already uses the pool
+    if (curl_share_setopt(curl_sh_.get(), CURLSHOPT_SHARE, CURL_LOCK_DATA_COOKIE) != CURLSHE_OK) {
+        throw std::invalid_argument("Unable to share cookies through a connection pool already in use");
+    }
+    holder_ = std::make_shared<CurlHolder>();
+    SetupHandler(holder_->handle);
+}
+
+void CookieJar::Add(const Cookie& cookie) {
+    if (cookie.GetDomain().empty()) {
+        throw std::invalid_argument("Unable to add cookie '" + cookie.GetName() + "' without a domain to the cookie jar");
+    }
+    if (containsLineBreakOrTab(cookie.GetDomain()) || containsLineBreakOrTab(cookie.GetPath()) || containsLineBreakOrTab(cookie.GetName()) || containsLineBreakOrTab(cookie.GetValue())) {
+        throw std::invalid_argument("Unable to add cookie '" + cookie.GetName() + "' containing tabs or line breaks to the cookie jar");
+    }
+    setList(toNetscapeLine(cookie).c_str());
+}
+
+void CookieJar::Add(const Cookies& cookies) {
+    for (const Cookie& cookie : cookies) {
+        Add(cookie);
+    }
+}
+
+Cookies CookieJar::GetCookies() const {
+    curl_slist* raw_cookies{nullptr};
+    {
+        const std::lock_guard<std::mutex> lock(*holder_mutex_);
+        curl_easy_getinfo(holder_->handle, CURLINFO_COOKIELIST, &raw_cookies);
+    }
+    // Parsed lazily on first access
+    return Cookies{std::shared_ptr<curl_slist>(raw_cookies, curl_slist_free_all)};
+}
+
+void CookieJar::Clear() {
+    setList("ALL");
+}
+
+void CookieJar::ClearSessionCookies() {
+    setList("SESS");
+}
+
+bool CookieJar::IsSharedWith(const ConnectionPool& pool) const {
+    return curl_sh_ == pool.curl_sh_;
+}
+
+void CookieJar::SetupHandler(CURL* easy_handler) const {
+    curl_easy_setopt(easy_handler, CURLOPT_SHARE, curl_sh_.get());
+}
+
+void CookieJar::setList(const char* command) const {
+    const std::lock_guard<std::mutex> lock(*holder_mutex_);
+    curl_easy_setopt(holder_->handle, CURLOPT_COOKIELIST, command);
+}
+
+} // namespace cpr
@@ -1,11 +1,16 @@
 #include "cpr/cookies.h"
 #include "cpr/curlholder.h"
+#include "cpr/url_encode.h"
+#include "cpr/util.h"
 #include <chrono>
 #include <ctime>
 #include <iomanip>
+#include <mutex>
 #include <sstream>
 #include <string>
 #include <string_view>
+#include <utility>
+#include <vector>
 
 namespace cpr {
 const std::string& Cookie::GetDomain() const {
@@ -50,67 +55,135 @@ const std::string& Cookie::GetValue() const {
     return value_;
 }
 
-std::string Cookies::GetEncoded(const CurlHolder& holder) const {
-    std::stringstream stream;
-    for (const cpr::Cookie& item : cookies_) {
+Cookies::Cookies(const Cookies& other) : encode{other.encode} {
+    const std::unique_lock lock(other.mutex_);
+    cookies_ = other.cookies_;
+    rawCookies_ = other.rawCookies_;
+    pending_ = other.pending_.load();
+}
+
+Cookies::Cookies(Cookies&& old) noexcept : encode{old.encode}, cookies_{std::move(old.cookies_)}, rawCookies_{std::move(old.rawCookies_)}, pending_{old.pending_.load()} {
+    old.pending_ = false;
+}
+
+Cookies& Cookies::operator=(const Cookies& other) {
+    if (this != &other) {
+        const std::scoped_lock lock(mutex_, other.mutex_);
+        encode = other.encode;
+        cookies_ = other.cookies_;
+        rawCookies_ = other.rawCookies_;
+        pending_ = other.pending_.load();
+    }
+    return *this;
+}
+
+Cookies& Cookies::operator=(Cookies&& old) noexcept {
+    if (this != &old) {
+        encode = old.encode;
+        cookies_ = std::move(old.cookies_);
+        rawCookies_ = std::move(old.rawCookies_);
+        pending_ = old.pending_.load();
+        old.pending_ = false;
+    }
+    return *this;
+}
+
+void Cookies::parse() const {
+    if (!pending_) {
+        return;
+    }
+
+    const std::unique_lock lock(mutex_);
+    if (pending_) {
+        Cookies parsed = util::parseCookies(rawCookies_.get());
+        cookies_.insert(cookies_.end(), parsed.cookies_.begin(), parsed.cookies_.end());
+        rawCookies_.reset();
+        pending_ = false;
+    }
+}
+
+std::vector<cpr::Cookie>& Cookies::get() {
+    parse();
+    return cookies_;
+}
+
+const std::vector<cpr::Cookie>& Cookies::get() const {
+    parse();
+    return cookies_;
+}
+
+std::string Cookies::GetEncoded(const CurlHolder& /*holder*/) const {
+    return GetEncoded();
+}
+
+std::string Cookies::GetEncoded() const {
+    std::string result;
+    const auto append = [this, &result](std::string_view s) {
+        if (encode) {
+            util::appendUrlEncoded(result, s);
+        } else {
+            result += s;
+        }
+    };
+    for (const cpr::Cookie& item : get()) {
         // Depending on if encoding is set to "true", we will URL-encode cookies
-        stream << (encode ? std::string_view{holder.urlEncode(item.GetName())} : std::string_view{item.GetName()}) << "=";
+        append(item.GetName());
+        result += "=";
 
         // special case version 1 cookies, which can be distinguished by
         // beginning and trailing quotes
         if (!item.GetValue().empty() && item.GetValue().front() == '"' && item.GetValue().back() == '"') {
-            stream << item.GetValue();
+            result += item.GetValue();
         } else {
-            // Depending on if encoding is set to "true", we will URL-encode cookies
-            stream << (encode ? std::string_view{holder.urlEncode(item.GetValue())} : std::string_view{item.GetValue()});
+            append(item.GetValue());
         }
-        stream << "; ";
+        result += "; ";
     }
-    return stream.str();
+    return result;
 }
 
 cpr::Cookie& Cookies::operator[](size_t pos) {
-    return cookies_[pos];
+    return get()[pos];
 }
 
 Cookies::iterator Cookies::begin() {
-    return cookies_.begin();
+    return get().begin();
 }
 
 Cookies::iterator Cookies::end() {
-    return cookies_.end();
+    return get().end();
 }
 
 Cookies::const_iterator Cookies::begin() const {
-    return cookies_.begin();
+    return get().cbegin();
 }
 
 Cookies::const_iterator Cookies::end() const {
-    return cookies_.end();
+    return get().cend();
 }
 
 Cookies::const_iterator Cookies::cbegin() const {
-    return cookies_.cbegin();
+    return get().cbegin();
 }
 
 Cookies::const_iterator Cookies::cend() const {
-    return cookies_.cend();
+    return get().cend();
 }
 
 void Cookies::emplace_back(const Cookie& str) {
-    cookies_.emplace_back(str);
+    get().emplace_back(str);
 }
 
 bool Cookies::empty() const {
-    return cookies_.empty();
+    return get().empty();
 }
 
 void Cookies::push_back(const Cookie& str) {
-    cookies_.push_back(str);
+    get().push_back(str);
 }
 
 void Cookies::pop_back() {
-    cookies_.pop_back();
+    get().pop_back();
 }
 
 } // namespace cpr
@@ -1,89 +1,128 @@
 #include "cpr/curl_container.h"
 #include "cpr/curlholder.h"
+#include "cpr/url_encode.h"
 #include <algorithm>
+#include <cstring>
 #include <initializer_list>
 #include <iterator>
+#include <memory_resource>
+#include <mutex>
 #include <string>
+#include <string_view>
+#include <vector>
 
 namespace cpr {
+namespace {
+// Parameters without a value only consist of their key, payload pairs always contain a '='
+bool hasValue(const Parameter& parameter) {
+    return !parameter.value.empty();
+}
+
+bool hasValue(const Pair& /*pair*/) {
+    return true;
+}
+
+// The keys of payload pairs never get encoded
+bool encodesKey(const Parameter& /*parameter*/) {
+    return true;
+}
+
+bool encodesKey(const Pair& /*pair*/) {
+    return false;
+}
+
+size_t fieldSize(std::string_view field, bool encode) {
+    return encode ? util::urlEncodedSize(field) : field.size();
+}
+
+char* writeField(std::string_view field, bool encode, char* output) {
+    if (encode) {
+        return output + util::urlEncode(field, output); // NOLINT (cppcoreguidelines-pro-bounds-pointer-arithmetic)
+    }
+    std::memcpy(output, field.data(), field.size());
+    return output + field.size(); // NOLINT (cppcoreguidelines-pro-bounds-pointer-arithmetic)
+}
+
+/**
+ * Joins the elements like 'key1=value1&key2=value2'.
+ * Computes the exact size first, so the result gets written into a single allocation.
+ **/
+template <class T>
+std::string buildContent(const std::vector<T>& elements, bool encode) {
+    size_t size = 0;
+    for (const T& element : elements) {
+        // Same rule as for writing: a separator only follows non-empty content (e.g. not an empty leading parameter)
+        if (size > 0) {
+            size++;
+        }
+        size += fieldSize(element.key, encode && encodesKey(element));
+        if (hasValue(element)) {
+            size += 1 + fieldSize(element.value, encode);
+        }
+    }
+
+    std::string content(size, '\0');
+    char* output = content.data();
+    // NOLINTBEGIN (cppcoreguidelines-pro-bounds-pointer-arithmetic)
+    for (const T& element : elements) {
+        if (output != content.data()) {
+            *output++ = '&';
+        }
+        output = writeField(element.key, encode && encodesKey(element), output);
+        if (hasValue(element)) {
+            *output++ = '=';
+            output = writeField(element.value, encode, output);
+        }
+    }
+    // NOLINTEND (cppcoreguidelines-pro-bounds-pointer-arithmetic)
+    return content;
+}
+} // namespace
+
 template <class T>
 CurlContainer<T>::CurlContainer(const std::initializer_list<T>& containerList) : containerList_(containerList) {}
 
 template <class T>
 void CurlContainer<T>::Add(const std::initializer_list<T>& containerList) {
     std::transform(containerList.begin(), containerList.end(), std::back_inserter(containerList_), [](const T& elem) { return std::move(elem); });
+    cache_.Reset();
 }
 
 template <class T>
 void CurlContainer<T>::Add(const T& element) {
     containerList_.push_back(std::move(element));
+    cache_.Reset();
 }
 
-template <>
-const std::string CurlContainer<Parameter>::GetContent(const CurlHolder& holder) const {
-    std::string content{};
-    for (const Parameter& parameter : containerList_) {
-        if (!content.empty()) {
-            content += "&";
-        }
-
-        const std::string escapedKey = encode ? std::string{holder.urlEncode(parameter.key)} : parameter.key;
-        if (parameter.value.empty()) {
-            content += escapedKey;
-        } else {
-            const std::string escapedValue = encode ? std::string{holder.urlEncode(parameter.value)} : parameter.value;
-            content += escapedKey + "=";
-            content += escapedValue;
-        }
-    }
-
-    return content;
+template <class T>
+const std::string CurlContainer<T>::GetContent(const CurlHolder& /*holder*/) const {
+    return getContent(encode);
 }
 
-template <>
-const std::string CurlContainer<Parameter>::GetContent() const {
-    std::string content{};
-    for (const Parameter& parameter : containerList_) {
-        if (!content.empty()) {
-            content += "&";
-        }
-
-        if (parameter.value.empty()) {
-            content += parameter.key;
-        } else {
-            content += parameter.key + "=";
-            content += parameter.value;
-        }
-    }
-
-    return content;
+template <class T>
+const std::string CurlContainer<T>::GetContent() const {
+    return getContent(false);
 }
 
-template <>
-const std::string CurlContainer<Pair>::GetContent(const CurlHolder& holder) const {
-    std::string content{};
-    for (const cpr::Pair& element : containerList_) {
-        if (!content.empty()) {
-            content += "&";
-        }
-        const std::string escaped = encode ? std::string{holder.urlEncode(element.value)} : element.value;
-        content += element.key + "=" + escaped;
-    }
+template <class T>
+std::pmr::string CurlContainer<T>::GetContent(const CurlHolder& /*holder*/, std::pmr::memory_resource* resource) const {
+    const std::lock_guard lock(cache_.mutex);
+    return std::pmr::string{cachedContent(encode), resource};
+}
 
-    return content;
+template <class T>
+const std::string CurlContainer<T>::getContent(bool p_encode) const {
+    const std::lock_guard lock(cache_.mutex);
+    return cachedContent(p_encode);
 }
 
-template <>
-const std::string CurlContainer<Pair>::GetContent() const {
-    std::string content{};
-    for (const cpr::Pair& element : containerList_) {
-        if (!content.empty()) {
-            content += "&";
-        }
-        content += element.key + "=" + element.value;
+template <class T>
+const std::string& CurlContainer<T>::cachedContent(bool p_encode) const {
+    // Toggling `encode` does not modify the container, so the cache also has to match it
+    if (!cache_.content || cache_.content->second != p_encode) {
+        cache_.content.emplace(buildContent(containerList_, p_encode), p_encode);
     }
-
-    return content;
+    return cache_.content->first;
 }
 
 template class CurlContainer<Pair>;
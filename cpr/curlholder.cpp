@@ -1,5 +1,6 @@
 #include "cpr/curlholder.h"
 #include "cpr/secure_string.h"
+#include "cpr/url_encode.h"
 #include <cassert>
 #include <curl/curl.h>
 #include <curl/easy.h>
@@ -22,7 +23,7 @@ CurlHolder::CurlHolder() {
     assert(handle);
 }
 
-CurlHolder::CurlHolder(CurlHolder&& old) noexcept : handle(old.handle), chunk(old.chunk), resolveCurlList(old.resolveCurlList), multipart(old.multipart), error(old.error) {
+CurlHolder::CurlHolder(CurlHolder&& old) noexcept : handle(old.handle), chunk(old.chunk), resolveCurlList(old.resolveCurlList), multipart(old.multipart), error(old.error), generation(old.generation) {
     // Avoid double free
     old.handle = nullptr;
     old.chunk = nullptr;
@@ -50,6 +51,7 @@ CurlHolder& CurlHolder::operator=(CurlHolder&& old) noexcept {
     resolveCurlList = old.resolveCurlList;
     multipart = old.multipart;
     error = old.error;
+    generation = old.generation;
 
     // Avoid double free
     old.handle = nullptr;
@@ -60,24 +62,10 @@ CurlHolder& CurlHolder::operator=(CurlHolder&& old) noexcept {
 }
 
 util::SecureString CurlHolder::urlEncode(std::string_view s) const {
-    assert(handle);
-    char* output = curl_easy_escape(handle, s.data(), static_cast<int>(s.length()));
-    if (output) {
-        util::SecureString result = output;
-        curl_free(output);
-        return result;
-    }
-    return "";
+    return util::urlEncodeSecure(s);
 }
 
 util::SecureString CurlHolder::urlDecode(std::string_view s) const {
-    assert(handle);
-    char* output = curl_easy_unescape(handle, s.data(), static_cast<int>(s.length()), nullptr);
-    if (output) {
-        util::SecureString result = output;
-        curl_free(output);
-        return result;
-    }
-    return "";
+    return util::urlDecodeSecure(s);
 }
 } // namespace cpr
@@ -0,0 +1,75 @@
+#include "cpr/file_body.h"
+
+#include <cstddef>
+#include <cstdio>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <utility>
+
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <sys/types.h>
+
+#include "cpr/cprtypes.h"
+#include "cpr/file.h"
+
+namespace cpr {
+
+FileBody::FileBody(std::string filepath) : filepath_(std::move(filepath)) {
+    std::FILE* file = std::fopen(filepath_.c_str(), "rb"); // NOLINT (cppcoreguidelines-owning-memory)
+    if (!file) {
+        throw std::invalid_argument("Can't open the file for HTTP request body!");
+    }
+    file_ = std::shared_ptr<std::FILE>(file, [](std::FILE* f) { std::fclose(f); }); // NOLINT (cppcoreguidelines-owning-memory)
+    // Data gets read straight into the buffer provided by libcurl, so buffering inside stdio would only add a copy
+    std::setvbuf(file, nullptr, _IONBF, 0);
+
+    // Take the size from the opened file instead of the path, so it matches what gets read
+#ifdef _WIN32
+    struct _stat64 info {};
+    if (_fstat64(_fileno(file), &info) != 0) {
+        throw std::invalid_argument("Can't determine the size of the file for HTTP request body!");
+    }
+#else
+    struct stat info {};
+    if (fstat(fileno(file), &info) != 0) {
+        throw std::invalid_argument("Can't determine the size of the file for HTTP request body!");
+    }
+#endif
+    size_ = static_cast<cpr_off_t>(info.st_size);
+
+#ifdef POSIX_FADV_SEQUENTIAL
+    // Allow the kernel to read ahead more aggressively
+    posix_fadvise(fileno(file), 0, 0, POSIX_FADV_SEQUENTIAL);
+#endif
+}
+
+FileBody::FileBody(const File& file) : FileBody(file.filepath) {}
+
+const std::string& FileBody::GetPath() const {
+    return filepath_;
+}
+
+cpr_off_t FileBody::GetSize() const {
+    return size_;
+}
+
+size_t FileBody::Read(char* buffer, size_t size) const {
+    return std::fread(buffer, 1, size, file_.get());
+}
+
+bool FileBody::Seek(cpr_off_t offset) const {
+    std::clearerr(file_.get());
+#ifdef _WIN32
+    return _fseeki64(file_.get(), offset, SEEK_SET) == 0;
+#else
+    return fseeko(file_.get(), static_cast<off_t>(offset), SEEK_SET) == 0;
+#endif
+}
+
+bool FileBody::HasError() const {
+    return std::ferror(file_.get()) != 0;
+}
+
+} // namespace cpr
@@ -0,0 +1,230 @@
+#include "cpr/file_sink.h"
+
+#include <algorithm>
+#include <cerrno>
+#include <cstddef>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <utility>
+
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <sys/types.h>
+
+#ifdef _WIN32
+#include <io.h>
+#else
+#include <unistd.h>
+#endif
+
+#include "cpr/cprtypes.h"
+
+namespace cpr {
+
+namespace {
+#ifdef _WIN32
+// Windows has no positional write, so seek and write instead. The sink never shares the descriptor.
+bool writeAll(int fd, const char* data, size_t size, cpr_off_t offset) {
+    if (_lseeki64(fd, offset, SEEK_SET) < 0) {
+        return false;
+    }
+    while (size > 0) {
+        const unsigned int count = static_cast<unsigned int>(std::min<size_t>(size, 1U << 30U));
+        const int written = _write(fd, data, count);
+        if (written <= 0) {
+            return false;
+        }
+        data += written; // NOLINT (cppcoreguidelines-pro-bounds-pointer-arithmetic)
+        size -= static_cast<size_t>(written);
+    }
+    return true;
+}
+
+size_t readAt(int fd, char* data, size_t size, cpr_off_t offset) {
+    if (_lseeki64(fd, offset, SEEK_SET) < 0) {
+        return 0;
+    }
+    size_t total = 0;
+    while (total < size) {
+        const unsigned int count = static_cast<unsigned int>(std::min<size_t>(size - total, 1U << 30U));
+        const int read = _read(fd, data + total, count); // NOLINT (cppcoreguidelines-pro-bounds-pointer-arithmetic)
+        if (read <= 0) {
+            break;
+        }
+        total += static_cast<size_t>(read);
+    }
+    return total;
+}
+#else
+bool writeAll(int fd, const char* data, size_t size, cpr_off_t offset) {
+    while (size > 0) {
+        const ssize_t written = pwrite(fd, data, size, static_cast<off_t>(offset));
+        if (written < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            return false;
+        }
+        data += written; // NOLINT (cppcoreguidelines-pro-bounds-pointer-arithmetic)
+        size -= static_cast<size_t>(written);
+        offset += written;
+    }
+    return true;
+}
+
+size_t readAt(int fd, char* data, size_t size, cpr_off_t offset) {
+    size_t total = 0;
+    while (total < size) {
+        // NOLINTNEXTLINE (cppcoreguidelines-pro-bounds-pointer-arithmetic)
+        const ssize_t read = pread(fd, data + total, size - total, static_cast<off_t>(offset + static_cast<cpr_off_t>(total)));
+        if (read < 0 && errno == EINTR) {
+            continue;
+        }
+        if (read <= 0) {
+            break;
+        }
+        total += static_cast<size_t>(read);
+    }
+    return total;
+}
+#endif
+} // namespace
+
+FileSink::FileSink(std::string filepath, size_t buffer_size, bool sync, bool append) : filepath_(std::move(filepath)), sync_(sync) {
+    if (buffer_size == 0) {
+        throw std::invalid_argument("The buffer size of a FileSink has to be greater than zero.");
+    }
+#ifdef _WIN32
+    fd_ = _open(filepath_.c_str(), _O_RDWR | _O_CREAT | _O_BINARY | (append ? 0 : _O_TRUNC), _S_IREAD | _S_IWRITE);
+#else
+    fd_ = open(filepath_.c_str(), O_RDWR | O_CREAT | O_CLOEXEC | (append ? 0 : O_TRUNC), 0644); // NOLINT (cppcoreguidelines-pro-type-vararg, hicpp-vararg)
+#endif
+    if (fd_ < 0) {
+        throw std::system_error(errno, std::generic_category(), "Can't open the file '" + filepath_ + "' for the download");
+    }
+    if (append) {
+#ifdef _WIN32
+        const cpr_off_t end = _lseeki64(fd_, 0, SEEK_END);
+#else
+        const cpr_off_t end = lseek(fd_, 0, SEEK_END);
+#endif
+        kept_size_ = end > 0 ? static_cast<size_t>(end) : 0;
+        buffer_offset_ = kept_size_;
+        size_ = kept_size_;
+    }
+    buffer_.resize(buffer_size);
+}
+
+FileSink::~FileSink() {
+    flushBuffer();
+#ifdef _WIN32
+    _close(fd_);
+#else
+    close(fd_);
+#endif
+}
+
+size_t FileSink::Write(std::string_view data) {
+    const size_t size = data.size();
+    if (buffered_ + data.size() > buffer_.size()) {
+        if (buffered_ > 0) {
+            // Top up the buffer first, so the file keeps getting written in whole buffers at buffer aligned offsets
+            const size_t count = buffer_.size() - buffered_;
+            std::memcpy(buffer_.data() + buffered_, data.data(), count); // NOLINT (cppcoreguidelines-pro-bounds-pointer-arithmetic)
+            buffered_ += count;
+            data.remove_prefix(count);
+            if (!flushBuffer()) {
+                return 0;
+            }
+        }
+        // Whole buffers would only be copied to get written right away, so write them directly instead
+        const size_t direct = data.size() - (data.size() % buffer_.size());
+        if (direct > 0) {
+            if (!writeAll(fd_, data.data(), direct, static_cast<cpr_off_t>(buffer_offset_))) {
+                return 0;
+            }
+            buffer_offset_ += direct;
+            data.remove_prefix(direct);
+        }
+    }
+    std::memcpy(buffer_.data() + buffered_, data.data(), data.size()); // NOLINT (cppcoreguidelines-pro-bounds-pointer-arithmetic)
+    buffered_ += data.size();
+    size_ = std::max(size_, buffer_offset_ + buffered_);
+    return size;
+}
+
+size_t FileSink::WriteAt(cpr_off_t offset, std::string_view data) {
+    if (offset < 0 || !writeAll(fd_, data.data(), data.size(), offset)) {
+        return 0;
+    }
+    size_ = std::max(size_, static_cast<size_t>(offset) + data.size());
+    return data.size();
+}
+
+void FileSink::Reserve(size_t size) {
+#if defined(__linux__) && defined(FALLOC_FL_KEEP_SIZE)
+    // Only a hint, so the download does not fail on file systems not supporting it.
+    // Keeping the size makes sure the file does not end up with trailing zeros in case the transfer gets aborted.
+    [[maybe_unused]] const int result = fallocate(fd_, FALLOC_FL_KEEP_SIZE, static_cast<off_t>(kept_size_), static_cast<off_t>(size));
+#else
+    static_cast<void>(size);
+#endif
+}
+
+void FileSink::Clear() {
+    buffered_ = 0;
+    buffer_offset_ = kept_size_;
+    size_ = kept_size_;
+#ifdef _WIN32
+    _chsize_s(fd_, static_cast<cpr_off_t>(kept_size_));
+#else
+    [[maybe_unused]] const int result = ftruncate(fd_, static_cast<off_t>(kept_size_));
+#endif
+}
+
+bool FileSink::Flush() {
+    if (!flushBuffer()) {
+        return false;
+    }
+    if (!sync_) {
+        return true;
+    }
+#ifdef _WIN32
+    return _commit(fd_) == 0;
+#else
+    return fsync(fd_) == 0;
+#endif
+}
+
+size_t FileSink::GetSize() const {
+    return size_;
+}
+
+std::string FileSink::GetString() const {
+    std::string result(size_, '\0');
+    readAt(fd_, result.data(), size_, 0);
+    // Data not flushed yet only exists inside the buffer
+    std::memcpy(result.data() + buffer_offset_, buffer_.data(), buffered_); // NOLINT (cppcoreguidelines-pro-bounds-pointer-arithmetic)
+    return result;
+}
+
+const std::string& FileSink::GetPath() const {
+    return filepath_;
+}
+
+bool FileSink::flushBuffer() {
+    if (buffered_ == 0) {
+        return true;
+    }
+    if (!writeAll(fd_, buffer_.data(), buffered_, static_cast<cpr_off_t>(buffer_offset_))) {
+        return false;
+    }
+    buffer_offset_ += buffered_;
+    buffered_ = 0;
+    return true;
+}
+
+} // namespace cpr
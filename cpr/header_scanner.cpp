@@ -0,0 +1,29 @@
+#include "cpr/header_scanner.h"
+
+#include <cstddef>
+#include <cstring>
+#include <string_view>
+#include <vector>
+
+namespace cpr::util {
+
+HeaderLine scanHeaderLine(std::string_view data, size_t start) {
+    const char* begin = data.data();
+    // NOLINTBEGIN (cppcoreguidelines-pro-bounds-pointer-arithmetic)
+    const char* line = begin + start;
+    const auto* newline = static_cast<const char*>(std::memchr(line, '\n', data.size() - start));
+    const size_t end = newline == nullptr ? data.size() : static_cast<size_t>(newline - begin);
+    const auto* colon = static_cast<const char*>(std::memchr(line, ':', end - start));
+    // NOLINTEND (cppcoreguidelines-pro-bounds-pointer-arithmetic)
+    return HeaderLine{start, colon == nullptr ? std::string_view::npos : static_cast<size_t>(colon - begin), end};
+}
+
+void scanHeaderLines(std::string_view data, std::vector<HeaderLine>& lines) {
+    size_t start = 0;
+    while (start < data.size()) {
+        lines.push_back(scanHeaderLine(data, start));
+        start = lines.back().end + 1;
+    }
+}
+
+} // namespace cpr::util
@@ -14,6 +14,7 @@
 #include <functional>
 #include <iosfwd>
 #include <iostream>
+#include <iterator>
 #include <memory>
 #include <optional>
 #include <stdexcept>
@@ -68,10 +69,21 @@ void MultiPerform::AddSession(std::shared_ptr<Session>& session, HttpMethod meth
     // Lock session to the multihandle
     session->isUsedInMultiPerform = true;
 
+    if (responseFields_) {
+        session->SetResponseFields(*responseFields_);
+    }
+
     // Add session to sessions_
     sessions_.emplace_back(session, method);
 }
 
+void MultiPerform::SetResponseFields(ResponseFields fields) {
+    responseFields_ = fields;
+    for (const std::pair<std::shared_ptr<Session>, HttpMethod>& pair : sessions_) {
+        pair.first->SetResponseFields(fields);
+    }
+}
+
 void MultiPerform::RemoveSession(const std::shared_ptr<Session>& session) {
     if (sessions_.empty()) {
         throw std::invalid_argument("Failed to find session!");
@@ -136,8 +148,8 @@ void MultiPerform::DoMultiPerform() {
 }
 
 std::vector<Response> MultiPerform::ReadMultiInfo(const std::function<Response(Session&, CURLcode)>& complete_function) {
-    // Get infos and create Response objects
-    std::vector<Response> responses;
+    // Get infos and create Response objects at the index of their session, so the order matches the order of added sessions
+    std::vector<std::optional<Response>> responses(sessions_.size());
     struct CURLMsg* info{nullptr};
     do {
         int msgq = 0;
@@ -156,7 +168,7 @@ std::vector<Response> MultiPerform::ReadMultiInfo(const std::function<Response(S
 
             // Add response object
             // NOLINTNEXTLINE (cppcoreguidelines-pro-type-union-access)
-            responses.push_back(complete_function(*current_session, info->data.result));
+            responses[static_cast<size_t>(std::distance(sessions_.begin(), it))] = complete_function(*current_session, info->data.result);
         }
     } while (info);
 
@@ -167,15 +179,12 @@ std::vector<Response> MultiPerform::ReadMultiInfo(const std::function<Response(S
         }
     }
 
-    // Sort response objects to match order of added sessions
     std::vector<Response> sorted_responses;
-    for (const auto& [session, _] : sessions_) {
-        Session& current_session = *session;
-        auto it = std::find_if(responses.begin(), responses.end(), [&current_session](const Response& response) { return current_session.curl_->handle == response.curl_->handle; });
-        const Response current_response = *it; // NOLINT (performance-unnecessary-copy-initialization) False positive
-        // Erase response from original vector to increase future search speed
-        responses.erase(it);
-        sorted_responses.push_back(current_response);
+    sorted_responses.reserve(responses.size());
+    for (std::optional<Response>& response : responses) {
+        if (response) {
+            sorted_responses.push_back(std::move(*response));
+        }
     }
     return sorted_responses;
 }
@@ -255,6 +264,18 @@ void MultiPerform::PrepareDownloadSession(size_t sessions_index, std::ofstream&
     }
 }
 
+void MultiPerform::PrepareDownloadSession(size_t sessions_index, const std::shared_ptr<ResponseSink>& sink) {
+    const auto& [session, method] = sessions_[sessions_index];
+    switch (method) {
+        case HttpMethod::DOWNLOAD_REQUEST:
+            session->PrepareDownload(sink);
+            break;
+        default:
+            std::cerr << "PrepareSessions failed: Undefined HttpMethod or non download method with arguments!" << '\n';
+            return;
+    }
+}
+
 void MultiPerform::SetHttpMethod(HttpMethod method) {
     for (auto& [_, session_method] : sessions_) {
         session_method = method;
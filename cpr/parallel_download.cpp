@@ -0,0 +1,218 @@
+#include "cpr/parallel_download.h"
+
+#include <algorithm>
+#include <cctype>
+#include <charconv>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <utility>
+#include <vector>
+
+#include <curl/curl.h>
+
+#include "cpr/accept_encoding.h"
+#include "cpr/callback.h"
+#include "cpr/curlholder.h"
+#include "cpr/error.h"
+#include "cpr/file_sink.h"
+#include "cpr/multiperform.h"
+#include "cpr/range.h"
+#include "cpr/response.h"
+#include "cpr/response_header.h"
+#include "cpr/session.h"
+#include "cpr/util.h"
+
+namespace cpr::priv {
+
+namespace {
+struct Segment {
+    std::int64_t begin{0};
+    // Inclusive, like the end of a Range
+    std::int64_t end{0};
+    std::int64_t received{0};
+    // Offset the current transfer has been requested at
+    std::int64_t transfer_begin{0};
+    // 'Content-Range' announced by the server for the current transfer
+    std::optional<std::pair<cpr_off_t, cpr_off_t>> announced;
+    // The current transfer sent a 'Content-Encoding' despite asking for the identity
+    bool encoded{false};
+    // Data of the current transfer got rejected by writeSegment(...)
+    bool rejected{false};
+    std::shared_ptr<Session> session;
+
+    [[nodiscard]] std::int64_t GetSize() const {
+        return end - begin + 1;
+    }
+    [[nodiscard]] bool IsComplete() const {
+        return received == GetSize();
+    }
+};
+
+std::int64_t parseLength(std::string_view value) {
+    std::int64_t length{-1};
+    const std::from_chars_result result = std::from_chars(value.data(), value.data() + value.size(), length); // NOLINT (cppcoreguidelines-pro-bounds-pointer-arithmetic)
+    return result.ec == std::errc() ? length : -1;
+}
+
+bool isContentEncoded(std::string_view header_line) {
+    constexpr std::string_view name{"content-encoding:"};
+    if (header_line.size() < name.size() || !std::equal(name.begin(), name.end(), header_line.begin(), [](char lower, char c) { return lower == std::tolower(static_cast<unsigned char>(c)); })) {
+        return false;
+    }
+    std::string_view value = header_line.substr(name.size());
+    const size_t value_begin = value.find_first_not_of(" \t");
+    const size_t value_end = value.find_last_not_of(" \t\r\n");
+    value = value_begin == std::string_view::npos ? std::string_view{} : value.substr(value_begin, value_end - value_begin + 1);
+    return !value.empty() && value != "identity";
+}
+
+/**
+ * Ranges refer to the bytes sent by the server. So the probe and all segments ask for the object without any content encoding
+ * and keep curl from decoding it, which would shift the offsets the data gets written at.
+ **/
+void requestIdentity(Session& session) {
+    session.SetAcceptEncoding(AcceptEncoding{AcceptEncodingMethods::disabled});
+    session.GetHeader()["Accept-Encoding"] = "identity";
+}
+
+bool readSegmentHeader(std::string_view header_line, Segment& segment) {
+    if (header_line.substr(0, 5) == "HTTP/") {
+        // Each response (e.g. after a redirect) announces its own range
+        segment.announced.reset();
+        segment.encoded = false;
+    } else if (isContentEncoded(header_line)) {
+        segment.encoded = true;
+    } else if (const std::optional<std::pair<cpr_off_t, cpr_off_t>> range = util::parseContentRange(header_line)) {
+        segment.announced = range;
+    }
+    return true;
+}
+
+bool writeSegment(std::string_view data, Segment& segment, CURL* handle, FileSink& sink) {
+    // Neither error pages nor the whole object (in case the range got ignored) must end up at the offset of the segment
+    // NOLINTNEXTLINE (google-runtime-int)
+    long status_code{};
+    curl_easy_getinfo(handle, CURLINFO_RESPONSE_CODE, &status_code);
+    if (status_code != 206 || !segment.announced || segment.encoded) {
+        segment.rejected = true;
+        return false;
+    }
+    // The server has to send exactly the requested range, or a prefix of it
+    const auto [first, last] = *segment.announced;
+    const std::int64_t offset = segment.begin + segment.received;
+    if (first != segment.transfer_begin || last > segment.end || static_cast<std::int64_t>(data.size()) > last + 1 - offset) {
+        segment.rejected = true;
+        return false;
+    }
+    if (sink.WriteAt(offset, data) != data.size()) {
+        return false;
+    }
+    segment.received += static_cast<std::int64_t>(data.size());
+    return true;
+}
+
+Response singleDownload(const std::shared_ptr<FileSink>& sink, const std::function<void(Session&)>& setup) {
+    Session session;
+    setup(session);
+    return session.Download(sink);
+}
+} // namespace
+
+Response parallel_download(const std::string& filepath, size_t segments, const std::function<void(Session&)>& setup) {
+    const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    const std::shared_ptr<FileSink> sink = std::make_shared<FileSink>(filepath);
+
+    Response response;
+    {
+        Session probe;
+        setup(probe);
+        requestIdentity(probe);
+        response = probe.Head();
+    }
+    const ResponseHeader header = response.GetHeaderView();
+    const std::int64_t length = response.error ? -1 : parseLength(header["Content-Length"]);
+    const bool encoded = !header["Content-Encoding"].empty() && header["Content-Encoding"] != "identity";
+    if (segments <= 1 || length <= 1 || response.status_code != 200 || header["Accept-Ranges"] != "bytes" || encoded) {
+        return singleDownload(sink, setup);
+    }
+
+    sink->Reserve(static_cast<size_t>(length));
+    const std::int64_t count = std::min(static_cast<std::int64_t>(std::min(segments, PARALLEL_DOWNLOAD_MAX_SEGMENTS)), length);
+    std::vector<Segment> parts(static_cast<size_t>(count));
+    for (std::int64_t i = 0; i < count; i++) {
+        Segment& segment = parts[static_cast<size_t>(i)];
+        segment.begin = length * i / count;
+        segment.end = length * (i + 1) / count - 1;
+        segment.session = std::make_shared<Session>();
+        setup(*segment.session);
+        requestIdentity(*segment.session);
+        CURL* handle = segment.session->GetCurlHolder()->handle;
+        segment.session->SetHeaderCallback(HeaderCallback{[&segment](std::string_view header_line, intptr_t /*userdata*/) { return readSegmentHeader(header_line, segment); }});
+        segment.session->SetWriteCallback(WriteCallback{[&segment, handle, &sink](std::string_view data, intptr_t /*userdata*/) { return writeSegment(data, segment, handle, *sink); }});
+    }
+
+    Error error;
+    // NOLINTNEXTLINE (google-runtime-int)
+    long status_code = response.status_code;
+    for (size_t attempt = 0; attempt <= PARALLEL_DOWNLOAD_RETRIES; attempt++) {
+        MultiPerform multi;
+        std::vector<Segment*> pending;
+        for (Segment& segment : parts) {
+            if (!segment.IsComplete()) {
+                // Continue where the previous attempt stopped
+                segment.transfer_begin = segment.begin + segment.received;
+                segment.announced.reset();
+                segment.encoded = false;
+                segment.rejected = false;
+                segment.session->SetRange(Range{segment.transfer_begin, segment.end});
+                multi.AddSession(segment.session);
+                pending.push_back(&segment);
+            }
+        }
+        if (pending.empty()) {
+            break;
+        }
+
+        // Responses only exist for sessions curl reported as done, so each segment gets checked through its own handle
+        multi.Get();
+        for (const Segment* segment : pending) {
+            const std::shared_ptr<CurlHolder> holder = segment->session->GetCurlHolder();
+            // NOLINTNEXTLINE (google-runtime-int)
+            long segment_status_code{};
+            curl_easy_getinfo(holder->handle, CURLINFO_RESPONSE_CODE, &segment_status_code);
+            if (segment_status_code == 200 || segment->encoded) {
+                // The range got ignored or the object got encoded after all, so only a single download is possible
+                return singleDownload(sink, setup);
+            }
+            if (!segment->IsComplete()) {
+                std::string message{holder->error.data()};
+                error = Error{segment->rejected ? CURLE_WRITE_ERROR : CURLE_PARTIAL_FILE, message.empty() ? std::string{"Segment incomplete"} : std::move(message)};
+                status_code = segment_status_code;
+            }
+        }
+    }
+
+    const bool complete = std::all_of(parts.begin(), parts.end(), [](const Segment& segment) { return segment.IsComplete(); });
+    if (complete) {
+        error = sink->Flush() ? Error{} : Error{CURLE_WRITE_ERROR, "Failed to flush the download sink"};
+        status_code = response.status_code;
+    }
+    response.error = std::move(error);
+    response.status_code = status_code;
+    response.downloaded_bytes = 0;
+    for (const Segment& segment : parts) {
+        response.downloaded_bytes += segment.received;
+    }
+    response.elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    response.sink = sink;
+    return response;
+}
+
+} // namespace cpr::priv
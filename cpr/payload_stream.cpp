@@ -0,0 +1,81 @@
+#include "cpr/payload_stream.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <string_view>
+
+#include "cpr/cprtypes.h"
+#include "cpr/url_encode.h"
+
+namespace cpr {
+
+cpr_off_t PayloadStream::GetSize() {
+    Rewind();
+    cpr_off_t size = 0;
+    bool first = true;
+    const PairVisitor count = [this, &size, &first](std::string_view key, std::string_view value) {
+        // '&' in front of all pairs except the first one and '=' between the key and the value
+        size += static_cast<cpr_off_t>((first ? 1 : 2) + key.size() + (encode ? util::urlEncodedSize(value) : value.size()));
+        first = false;
+    };
+    while (next_(count)) {}
+    Rewind();
+    return size;
+}
+
+size_t PayloadStream::Read(char* buffer, size_t size) {
+    size_t written = 0;
+    const PairVisitor write = [this, buffer, size, &written](std::string_view key, std::string_view value) {
+        const size_t value_size = encode ? util::urlEncodedSize(value) : value.size();
+        const size_t pair_size = (first_ ? 1 : 2) + key.size() + value_size;
+        // Pairs fitting into the buffer get encoded straight into it, only the remaining ones take a detour
+        char* output = buffer + written; // NOLINT (cppcoreguidelines-pro-bounds-pointer-arithmetic)
+        if (pair_size > size - written) {
+            pending_.resize(pair_size);
+            pendingOffset_ = 0;
+            output = pending_.data();
+        }
+        // NOLINTBEGIN (cppcoreguidelines-pro-bounds-pointer-arithmetic)
+        if (!first_) {
+            *output++ = '&';
+        }
+        output = std::copy(key.begin(), key.end(), output);
+        *output++ = '=';
+        if (encode) {
+            util::urlEncode(value, output);
+        } else {
+            std::copy(value.begin(), value.end(), output);
+        }
+        // NOLINTEND (cppcoreguidelines-pro-bounds-pointer-arithmetic)
+        if (pending_.empty()) {
+            written += pair_size;
+        }
+        first_ = false;
+    };
+
+    while (written < size) {
+        if (!pending_.empty()) {
+            const size_t count = std::min(pending_.size() - pendingOffset_, size - written);
+            std::copy_n(pending_.data() + pendingOffset_, count, buffer + written); // NOLINT (cppcoreguidelines-pro-bounds-pointer-arithmetic)
+            written += count;
+            pendingOffset_ += count;
+            if (pendingOffset_ == pending_.size()) {
+                // Keeps the capacity for the next pair not fitting
+                pending_.clear();
+                pendingOffset_ = 0;
+            }
+        } else if (!next_(write)) {
+            break;
+        }
+    }
+    return written;
+}
+
+void PayloadStream::Rewind() {
+    rewind_();
+    pending_.clear();
+    pendingOffset_ = 0;
+    first_ = true;
+}
+
+} // namespace cpr
@@ -0,0 +1,19 @@
+#include "cpr/request_arena.h"
+
+#include <cstddef>
+#include <memory>
+#include <memory_resource>
+
+namespace cpr {
+RequestArena::State::State(size_t initial_size) : buffer(initial_size), resource(buffer.data(), buffer.size(), std::pmr::new_delete_resource()) {}
+
+RequestArena::RequestArena(size_t initial_size) : state_(std::make_shared<State>(initial_size)) {}
+
+std::pmr::memory_resource* RequestArena::GetResource() const {
+    return &state_->resource;
+}
+
+void RequestArena::Release() const {
+    state_->resource.release();
+}
+} // namespace cpr
@@ -0,0 +1,241 @@
+#include "cpr/request_compression.h"
+
+#include <algorithm>
+#include <climits>
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <utility>
+
+#include <curl/curl.h>
+
+#ifdef CPR_ZLIB_SUPPORT
+#include <zlib.h>
+#endif
+#ifdef CPR_ZSTD_SUPPORT
+#include <zstd.h>
+#endif
+
+namespace cpr {
+
+bool RequestCompression::IsSupported(RequestCompressionMethod method) {
+    switch (method) {
+        case RequestCompressionMethod::identity:
+            return true;
+        case RequestCompressionMethod::gzip:
+#ifdef CPR_ZLIB_SUPPORT
+            return true;
+#else
+            return false;
+#endif
+        case RequestCompressionMethod::zstd:
+#ifdef CPR_ZSTD_SUPPORT
+            return true;
+#else
+            return false;
+#endif
+    }
+    return false;
+}
+
+const char* RequestCompression::GetContentEncoding() const {
+    switch (method) {
+        case RequestCompressionMethod::gzip:
+            return "gzip";
+        case RequestCompressionMethod::zstd:
+            return "zstd";
+        case RequestCompressionMethod::identity:
+            break;
+    }
+    return "identity";
+}
+
+namespace util {
+
+struct Compressor::State {
+    RequestCompressionMethod method{RequestCompressionMethod::identity};
+#ifdef CPR_ZLIB_SUPPORT
+    z_stream zlib{};
+    bool zlib_initialized{false};
+#endif
+#ifdef CPR_ZSTD_SUPPORT
+    ZSTD_CCtx* zstd{nullptr};
+#endif
+
+    State() = default;
+    State(const State& other) = delete;
+    State(State&& old) = delete;
+    State& operator=(const State& other) = delete;
+    State& operator=(State&& old) = delete;
+    ~State() {
+#ifdef CPR_ZLIB_SUPPORT
+        if (zlib_initialized) {
+            deflateEnd(&zlib);
+        }
+#endif
+#ifdef CPR_ZSTD_SUPPORT
+        ZSTD_freeCCtx(zstd);
+#endif
+    }
+};
+
+Compressor::Compressor(const RequestCompression& compression) : state_(std::make_unique<State>()) {
+    if (compression.method == RequestCompressionMethod::identity || !RequestCompression::IsSupported(compression.method)) {
+        throw std::invalid_argument("The request compression method is not supported by this build of cpr.");
+    }
+    state_->method = compression.method;
+#ifdef CPR_ZLIB_SUPPORT
+    if (compression.method == RequestCompressionMethod::gzip) {
+        if (!compression.dictionary.empty()) {
+            throw std::invalid_argument("Dictionaries are only supported by zstd request compression.");
+        }
+        // 16 added to the window bits selects the gzip format instead of the zlib one
+        const int window_bits = 15 + 16;
+        const int memory_level = 8;
+        if (deflateInit2(&state_->zlib, compression.level.value_or(Z_DEFAULT_COMPRESSION), Z_DEFLATED, window_bits, memory_level, Z_DEFAULT_STRATEGY) != Z_OK) {
+            throw std::invalid_argument("Invalid gzip request compression level.");
+        }
+        state_->zlib_initialized = true;
+    }
+#endif
+#ifdef CPR_ZSTD_SUPPORT
+    if (compression.method == RequestCompressionMethod::zstd) {
+        state_->zstd = ZSTD_createCCtx();
+        if (!state_->zstd) {
+            throw std::bad_alloc();
+        }
+        if (compression.level && ZSTD_isError(ZSTD_CCtx_setParameter(state_->zstd, ZSTD_c_compressionLevel, *compression.level))) {
+            throw std::invalid_argument("Invalid zstd request compression level.");
+        }
+        if (!compression.dictionary.empty() && ZSTD_isError(ZSTD_CCtx_loadDictionary(state_->zstd, compression.dictionary.data(), compression.dictionary.size()))) {
+            throw std::invalid_argument("Invalid zstd request compression dictionary.");
+        }
+    }
+#endif
+}
+
+Compressor::Compressor(Compressor&& old) noexcept = default;
+Compressor& Compressor::operator=(Compressor&& old) noexcept = default;
+Compressor::~Compressor() = default;
+
+// NOLINTNEXTLINE (readability-convert-member-functions-to-static)
+bool Compressor::Compress(std::string_view& input, char* output, size_t& output_size, bool finish) {
+#ifdef CPR_ZLIB_SUPPORT
+    if (state_->method == RequestCompressionMethod::gzip) {
+        z_stream& zlib = state_->zlib;
+        // zlib counts in 32 bit, so larger buffers get handled over multiple calls
+        const uInt input_size = static_cast<uInt>(std::min<size_t>(input.size(), UINT_MAX));
+        const uInt output_capacity = static_cast<uInt>(std::min<size_t>(output_size, UINT_MAX));
+        zlib.next_in = reinterpret_cast<Bytef*>(const_cast<char*>(input.data())); // NOLINT (cppcoreguidelines-pro-type-reinterpret-cast, cppcoreguidelines-pro-type-const-cast)
+        zlib.avail_in = input_size;
+        zlib.next_out = reinterpret_cast<Bytef*>(output); // NOLINT (cppcoreguidelines-pro-type-reinterpret-cast)
+        zlib.avail_out = output_capacity;
+        // Only the last part of the input may be compressed with Z_FINISH
+        const bool last = finish && input_size == input.size();
+        const int result = deflate(&zlib, last ? Z_FINISH : Z_NO_FLUSH);
+        if (result == Z_STREAM_ERROR) {
+            throw std::runtime_error("Failed to gzip the request body.");
+        }
+        input.remove_prefix(input_size - zlib.avail_in);
+        output_size = output_capacity - zlib.avail_out;
+        return result == Z_STREAM_END;
+    }
+#endif
+#ifdef CPR_ZSTD_SUPPORT
+    if (state_->method == RequestCompressionMethod::zstd) {
+        ZSTD_inBuffer in{input.data(), input.size(), 0};
+        ZSTD_outBuffer out{output, output_size, 0};
+        const size_t remaining = ZSTD_compressStream2(state_->zstd, &out, &in, finish ? ZSTD_e_end : ZSTD_e_continue);
+        if (ZSTD_isError(remaining)) {
+            throw std::runtime_error(std::string{"Failed to zstd compress the request body: "} + ZSTD_getErrorName(remaining));
+        }
+        input.remove_prefix(in.pos);
+        output_size = out.pos;
+        return finish && remaining == 0;
+    }
+#endif
+    static_cast<void>(input);
+    static_cast<void>(output);
+    static_cast<void>(finish);
+    output_size = 0;
+    return true;
+}
+
+// NOLINTNEXTLINE (readability-convert-member-functions-to-static)
+void Compressor::Reset() {
+#ifdef CPR_ZLIB_SUPPORT
+    if (state_->method == RequestCompressionMethod::gzip) {
+        deflateReset(&state_->zlib);
+    }
+#endif
+#ifdef CPR_ZSTD_SUPPORT
+    if (state_->method == RequestCompressionMethod::zstd) {
+        // Only resetting the session keeps the parameters and the dictionary
+        ZSTD_CCtx_reset(state_->zstd, ZSTD_reset_session_only);
+    }
+#endif
+}
+
+std::string Compressor::CompressAll(const RequestCompression& compression, std::string_view data) {
+    Compressor compressor{compression};
+    // Text bodies usually shrink to a fraction of their size, grow in case they do not
+    std::string result(data.size() / 4 + 1024, '\0');
+    size_t written = 0;
+    while (true) {
+        if (written == result.size()) {
+            result.resize(result.size() * 2);
+        }
+        size_t size = result.size() - written;
+        const bool done = compressor.Compress(data, result.data() + written, size, true); // NOLINT (cppcoreguidelines-pro-bounds-pointer-arithmetic)
+        written += size;
+        if (done) {
+            break;
+        }
+    }
+    result.resize(written);
+    return result;
+}
+
+CompressionStream::CompressionStream(const RequestCompression& compression, std::function<bool(char* buffer, size_t& size)> read, std::function<bool()> rewind) : compressor_(compression), read_(std::move(read)), rewind_(std::move(rewind)), buffer_(BUFFER_SIZE) {}
+
+size_t CompressionStream::Read(char* buffer, size_t size) {
+    try {
+        size_t written = 0;
+        // Compressed data may lag behind, so keep reading until there is something to return
+        while (written == 0 && !done_) {
+            if (pending_.empty() && !finished_) {
+                size_t read = buffer_.size();
+                if (!read_(buffer_.data(), read)) {
+                    return CURL_READFUNC_ABORT;
+                }
+                read = std::min(read, buffer_.size());
+                finished_ = read == 0;
+                pending_ = std::string_view{buffer_.data(), read};
+            }
+            size_t output_size = size - written;
+            done_ = compressor_.Compress(pending_, buffer + written, output_size, finished_); // NOLINT (cppcoreguidelines-pro-bounds-pointer-arithmetic)
+            written += output_size;
+        }
+        return written;
+    } catch (const std::runtime_error&) {
+        return CURL_READFUNC_ABORT;
+    }
+}
+
+bool CompressionStream::Rewind() {
+    if (!rewind_ || !rewind_()) {
+        return false;
+    }
+    compressor_.Reset();
+    pending_ = {};
+    finished_ = false;
+    done_ = false;
+    return true;
+}
+
+} // namespace util
+
+} // namespace cpr
@@ -1,59 +1,162 @@
 #include "cpr/response.h"
 #include <cassert>
+#include <chrono>
+#include <cpr/buffer_pool.h>
 #include <cpr/cert_info.h>
 #include <cpr/cookies.h>
 #include <cpr/cprtypes.h>
 #include <cpr/curlholder.h>
 #include <cpr/error.h>
+#include <cpr/response_fields.h>
+#include <cpr/response_header.h>
 #include <cpr/util.h>
 #include <curl/curl.h>
 #include <curl/curlver.h>
 #include <memory>
+#include <optional>
+#include <stdexcept>
 #include <string>
 #include <utility>
 #include <vector>
 
 namespace cpr {
 
-Response::Response(std::shared_ptr<CurlHolder> curl, std::string&& p_text, std::string&& p_header_string, Cookies&& p_cookies = Cookies{}, Error&& p_error = Error{}) : curl_(std::move(curl)), text(std::move(p_text)), cookies(std::move(p_cookies)), error(std::move(p_error)), raw_header(std::move(p_header_string)) {
-    header = cpr::util::parseHeader(raw_header, &status_line, &reason);
+Response::Response(std::shared_ptr<CurlHolder> curl, std::string&& p_text, std::string&& p_header_string, Cookies&& p_cookies, Error&& p_error, ResponseFields p_fields) : curl_(std::move(curl)), generation_(curl_ ? curl_->generation : 0), text(std::move(p_text)), cookies(std::move(p_cookies)), error(std::move(p_error)), raw_header(std::move(p_header_string)) {
     assert(curl_);
     assert(curl_->handle);
-    curl_easy_getinfo(curl_->handle, CURLINFO_RESPONSE_CODE, &status_code);
-    curl_easy_getinfo(curl_->handle, CURLINFO_TOTAL_TIME, &elapsed);
-    const char* url_string{nullptr};
-    curl_easy_getinfo(curl_->handle, CURLINFO_EFFECTIVE_URL, &url_string);
-    url = Url(url_string);
+    LoadFields(p_fields);
+}
+
+void Response::LoadFields(ResponseFields fields) {
+    // Only load fields not loaded yet
+    fields &= ~loadedFields_;
+    if (!any(fields)) {
+        return;
+    }
+
+    if (any(fields & ResponseFields::HEADER)) {
+        header = cpr::util::parseHeader(raw_header, &status_line, &reason);
+        loadedFields_ |= ResponseFields::HEADER;
+    }
+
+    // All other fields require the curl handle
+    fields &= ~ResponseFields::HEADER;
+    if (!any(fields) || !curl_) {
+        return;
+    }
+    checkGeneration();
+    if (any(fields & ResponseFields::STATUS_CODE)) {
+        curl_easy_getinfo(curl_->handle, CURLINFO_RESPONSE_CODE, &status_code);
+    }
+    if (any(fields & ResponseFields::ELAPSED)) {
+        curl_easy_getinfo(curl_->handle, CURLINFO_TOTAL_TIME, &elapsed);
+    }
+    if (any(fields & ResponseFields::URL)) {
+        const char* url_string{nullptr};
+        curl_easy_getinfo(curl_->handle, CURLINFO_EFFECTIVE_URL, &url_string);
+        url = Url(url_string);
+    }
+    if (any(fields & ResponseFields::TRANSFER_SIZES)) {
 #if LIBCURL_VERSION_NUM >= 0x073700 // 7.55.0
-    curl_easy_getinfo(curl_->handle, CURLINFO_SIZE_DOWNLOAD_T, &downloaded_bytes);
-    curl_easy_getinfo(curl_->handle, CURLINFO_SIZE_UPLOAD_T, &uploaded_bytes);
+        curl_easy_getinfo(curl_->handle, CURLINFO_SIZE_DOWNLOAD_T, &downloaded_bytes);
+        curl_easy_getinfo(curl_->handle, CURLINFO_SIZE_UPLOAD_T, &uploaded_bytes);
 #else
-    double downloaded_bytes_double, uploaded_bytes_double;
-    curl_easy_getinfo(curl_->handle, CURLINFO_SIZE_DOWNLOAD, &downloaded_bytes_double);
-    curl_easy_getinfo(curl_->handle, CURLINFO_SIZE_UPLOAD, &uploaded_bytes_double);
-    downloaded_bytes = downloaded_bytes_double;
-    uploaded_bytes = uploaded_bytes_double;
+        double downloaded_bytes_double, uploaded_bytes_double;
+        curl_easy_getinfo(curl_->handle, CURLINFO_SIZE_DOWNLOAD, &downloaded_bytes_double);
+        curl_easy_getinfo(curl_->handle, CURLINFO_SIZE_UPLOAD, &uploaded_bytes_double);
+        downloaded_bytes = downloaded_bytes_double;
+        uploaded_bytes = uploaded_bytes_double;
 #endif
-    curl_easy_getinfo(curl_->handle, CURLINFO_REDIRECT_COUNT, &redirect_count);
+    }
+    if (any(fields & ResponseFields::REDIRECT_COUNT)) {
+        curl_easy_getinfo(curl_->handle, CURLINFO_REDIRECT_COUNT, &redirect_count);
+    }
 #if LIBCURL_VERSION_NUM >= 0x071300 // 7.19.0
-    const char* ip_ptr{nullptr};
-    if (curl_easy_getinfo(curl_->handle, CURLINFO_PRIMARY_IP, &ip_ptr) == CURLE_OK && ip_ptr) {
-        primary_ip = ip_ptr;
+    if (any(fields & ResponseFields::PRIMARY_IP)) {
+        const char* ip_ptr{nullptr};
+        if (curl_easy_getinfo(curl_->handle, CURLINFO_PRIMARY_IP, &ip_ptr) == CURLE_OK && ip_ptr) {
+            primary_ip = ip_ptr;
+        }
     }
 #endif
 #if LIBCURL_VERSION_NUM >= 0x071500 // 7.21.0
-    // Ignored here since libcurl uses a long for this.
-    // NOLINTNEXTLINE(google-runtime-int)
-    long port = 0;
-    if (curl_easy_getinfo(curl_->handle, CURLINFO_PRIMARY_PORT, &port) == CURLE_OK) {
-        primary_port = port;
+    if (any(fields & ResponseFields::PRIMARY_PORT)) {
+        // Ignored here since libcurl uses a long for this.
+        // NOLINTNEXTLINE(google-runtime-int)
+        long port = 0;
+        if (curl_easy_getinfo(curl_->handle, CURLINFO_PRIMARY_PORT, &port) == CURLE_OK) {
+            primary_port = port;
+        }
     }
 #endif
+    if (any(fields & ResponseFields::TIMINGS)) {
+#if LIBCURL_VERSION_NUM >= 0x073D00 // 7.61.0
+        const auto getTime = [this](CURLINFO info) {
+            curl_off_t time{0};
+            curl_easy_getinfo(curl_->handle, info, &time);
+            return std::chrono::microseconds{time};
+        };
+        timings.name_lookup = getTime(CURLINFO_NAMELOOKUP_TIME_T);
+        timings.connect = getTime(CURLINFO_CONNECT_TIME_T);
+        timings.app_connect = getTime(CURLINFO_APPCONNECT_TIME_T);
+        timings.pre_transfer = getTime(CURLINFO_PRETRANSFER_TIME_T);
+        timings.start_transfer = getTime(CURLINFO_STARTTRANSFER_TIME_T);
+        timings.redirect = getTime(CURLINFO_REDIRECT_TIME_T);
+        timings.total = getTime(CURLINFO_TOTAL_TIME_T);
+#endif
+#if LIBCURL_VERSION_NUM >= 0x080600 // 8.6.0
+        timings.queue += getTime(CURLINFO_QUEUE_TIME_T);
+#endif
+    }
+    loadedFields_ |= fields;
+}
+
+void Response::checkGeneration() const {
+    if (curl_->generation != generation_) {
+        throw std::logic_error{"The session of this response already performed another request, so its curl handle no longer describes this response. Load the fields (or detach the response) before that."};
+    }
+}
+
+ResponseFields Response::GetLoadedFields() const {
+    return loadedFields_;
+}
+
+Response::~Response() noexcept {
+    if (bufferPool_) {
+        try {
+            bufferPool_->Release(std::move(text));
+            bufferPool_->Release(std::move(raw_header));
+        } catch (...) {
+            // Failing to recycle the buffers is not an error, they just get freed
+        }
+    }
+}
+
+void Response::Detach(bool include_cert_infos) {
+    if (!curl_) {
+        return;
+    }
+    LoadFields(ResponseFields::ALL);
+    if (include_cert_infos) {
+        certInfos_ = GetCertInfos();
+    }
+    curl_.reset();
+}
+
+bool Response::IsDetached() const {
+    return !curl_;
+}
+
+ResponseHeader Response::GetHeaderView() const {
+    return ResponseHeader{raw_header};
 }
 
 std::vector<CertInfo> Response::GetCertInfos() const {
-    assert(curl_);
+    if (!curl_) {
+        return certInfos_.value_or(std::vector<CertInfo>{});
+    }
     assert(curl_->handle);
+    checkGeneration();
     const curl_certinfo* ci{nullptr};
     curl_easy_getinfo(curl_->handle, CURLINFO_CERTINFO, &ci);
 
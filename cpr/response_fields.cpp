@@ -0,0 +1,39 @@
+#include "cpr/response_fields.h"
+#include <cstdint>
+
+namespace cpr {
+ResponseFields operator|(ResponseFields lhs, ResponseFields rhs) {
+    return static_cast<ResponseFields>(static_cast<uint16_t>(lhs) | static_cast<uint16_t>(rhs));
+}
+
+ResponseFields operator&(ResponseFields lhs, ResponseFields rhs) {
+    return static_cast<ResponseFields>(static_cast<uint16_t>(lhs) & static_cast<uint16_t>(rhs));
+}
+
+ResponseFields operator^(ResponseFields lhs, ResponseFields rhs) {
+    return static_cast<ResponseFields>(static_cast<uint16_t>(lhs) ^ static_cast<uint16_t>(rhs));
+}
+
+ResponseFields operator~(ResponseFields flag) {
+    return static_cast<ResponseFields>(~static_cast<uint16_t>(flag));
+}
+
+ResponseFields& operator|=(ResponseFields& lhs, ResponseFields rhs) {
+    lhs = static_cast<ResponseFields>(static_cast<uint16_t>(lhs) | static_cast<uint16_t>(rhs));
+    return lhs;
+}
+
+ResponseFields& operator&=(ResponseFields& lhs, ResponseFields rhs) {
+    lhs = static_cast<ResponseFields>(static_cast<uint16_t>(lhs) & static_cast<uint16_t>(rhs));
+    return lhs;
+}
+
+ResponseFields& operator^=(ResponseFields& lhs, ResponseFields rhs) {
+    lhs = static_cast<ResponseFields>(static_cast<uint16_t>(lhs) ^ static_cast<uint16_t>(rhs));
+    return lhs;
+}
+
+bool any(ResponseFields flag) {
+    return flag != ResponseFields::NONE;
+}
+} // namespace cpr
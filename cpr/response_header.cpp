@@ -0,0 +1,239 @@
+#include "cpr/response_header.h"
+
+#include <cstddef>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include "cpr/cprtypes.h"
+#include "cpr/header_scanner.h"
+
+namespace cpr {
+
+namespace {
+// Field names are ASCII tokens, so there is no need for the locale dependent std::tolower
+char toLowerAscii(char c) {
+    return c >= 'A' && c <= 'Z' ? static_cast<char>(c - 'A' + 'a') : c;
+}
+
+bool equalsCaseInsensitive(std::string_view a, std::string_view b) {
+    if (a.size() != b.size()) {
+        return false;
+    }
+    for (size_t i = 0; i < a.size(); i++) {
+        if (toLowerAscii(a[i]) != toLowerAscii(b[i])) {
+            return false;
+        }
+    }
+    return true;
+}
+
+size_t hashCaseInsensitive(std::string_view name) {
+    // FNV-1a
+    size_t hash = 14695981039346656037ULL;
+    for (const char c : name) {
+        hash = (hash ^ static_cast<unsigned char>(toLowerAscii(c))) * 1099511628211ULL;
+    }
+    return hash;
+}
+
+bool isWhitespace(char c) {
+    return c == ' ' || c == '\t' || c == '\r' || c == '\n';
+}
+} // namespace
+
+ResponseHeader::const_iterator::const_iterator(const ResponseHeader* header, size_t index) : header_(header), index_(index) {
+    if (index_ < header_->size()) {
+        value_ = header_->get(index_);
+    }
+}
+
+ResponseHeader::const_iterator& ResponseHeader::const_iterator::operator++() {
+    index_++;
+    value_ = index_ < header_->size() ? header_->get(index_) : value_type{};
+    return *this;
+}
+
+ResponseHeader::const_iterator ResponseHeader::const_iterator::operator++(int) {
+    const_iterator result = *this;
+    ++(*this);
+    return result;
+}
+
+ResponseHeader::ResponseHeader(std::string_view raw) : raw_(raw) {}
+
+ResponseHeader::ResponseHeader(const ResponseHeader& other) : raw_(other.raw_) {
+    // The index does not change anymore once built, so it can be shared by copying it
+    if (other.indexed_) {
+        fields_ = other.fields_;
+        indexed_ = true;
+    }
+}
+
+ResponseHeader::ResponseHeader(ResponseHeader&& old) noexcept : raw_(old.raw_) {
+    if (old.indexed_) {
+        fields_ = std::move(old.fields_);
+        indexed_ = true;
+    }
+    old.raw_ = {};
+    old.fields_.clear();
+    old.indexed_ = false;
+}
+
+ResponseHeader& ResponseHeader::operator=(const ResponseHeader& other) {
+    if (this != &other) {
+        raw_ = other.raw_;
+        fields_.clear();
+        indexed_ = false;
+        if (other.indexed_) {
+            fields_ = other.fields_;
+            indexed_ = true;
+        }
+    }
+    return *this;
+}
+
+ResponseHeader& ResponseHeader::operator=(ResponseHeader&& old) noexcept {
+    if (this != &old) {
+        raw_ = old.raw_;
+        fields_.clear();
+        indexed_ = false;
+        if (old.indexed_) {
+            fields_ = std::move(old.fields_);
+            indexed_ = true;
+        }
+        old.raw_ = {};
+        old.fields_.clear();
+        old.indexed_ = false;
+    }
+    return *this;
+}
+
+std::string_view ResponseHeader::operator[](std::string_view name) const {
+    const size_t index = indexOf(name);
+    return index < size() ? get(index).second : std::string_view{};
+}
+
+std::string_view ResponseHeader::at(std::string_view name) const {
+    const size_t index = indexOf(name);
+    if (index >= size()) {
+        throw std::out_of_range("Header field '" + std::string{name} + "' not found.");
+    }
+    return get(index).second;
+}
+
+ResponseHeader::const_iterator ResponseHeader::find(std::string_view name) const {
+    return const_iterator{this, indexOf(name)};
+}
+
+size_t ResponseHeader::count(std::string_view name) const {
+    return indexOf(name) < size() ? 1 : 0;
+}
+
+size_t ResponseHeader::size() const {
+    return fields().size();
+}
+
+bool ResponseHeader::empty() const {
+    return fields().empty();
+}
+
+ResponseHeader::const_iterator ResponseHeader::begin() const {
+    return const_iterator{this, 0};
+}
+
+ResponseHeader::const_iterator ResponseHeader::end() const {
+    return const_iterator{this, size()};
+}
+
+ResponseHeader::const_iterator ResponseHeader::cbegin() const {
+    return begin();
+}
+
+ResponseHeader::const_iterator ResponseHeader::cend() const {
+    return end();
+}
+
+ResponseHeader::operator Header() const {
+    Header header;
+    for (const value_type& field : *this) {
+        header[std::string{field.first}] = std::string{field.second};
+    }
+    return header;
+}
+
+const std::vector<ResponseHeader::Field>& ResponseHeader::fields() const {
+    if (indexed_) {
+        return fields_;
+    }
+
+    const std::unique_lock lock(mutex_);
+    if (indexed_) {
+        return fields_;
+    }
+
+    // Lines get indexed while scanning, so there is no need to collect them first
+    for (size_t next_line = 0; next_line < raw_.size();) {
+        const util::HeaderLine header_line = util::scanHeaderLine(raw_, next_line);
+        next_line = header_line.end + 1;
+        const size_t line_start = header_line.start;
+        const size_t colon = header_line.colon == std::string_view::npos ? std::string_view::npos : header_line.colon - line_start;
+        const std::string_view line = raw_.substr(line_start, header_line.end - line_start);
+
+        if (line.substr(0, 5) == "HTTP/") {
+            // A new response starts (e.g. after a redirect), so only keep its fields
+            fields_.clear();
+        } else {
+            if (colon != std::string_view::npos) {
+                size_t value_start = colon + 1;
+                size_t value_end = line.size();
+                while (value_start < value_end && (line[value_start] == ' ' || line[value_start] == '\t')) {
+                    value_start++;
+                }
+                while (value_end > value_start && isWhitespace(line[value_end - 1])) {
+                    value_end--;
+                }
+
+                const std::string_view name = line.substr(0, colon);
+                const Field field{hashCaseInsensitive(name), line_start, colon, line_start + value_start, value_end - value_start};
+                bool replaced = false;
+                for (Field& existing : fields_) {
+                    if (existing.name_hash == field.name_hash && equalsCaseInsensitive(raw_.substr(existing.name_offset, existing.name_length), name)) {
+                        // Last value wins, but keep the spelling of the first name like Header does
+                        existing.value_offset = field.value_offset;
+                        existing.value_length = field.value_length;
+                        replaced = true;
+                        break;
+                    }
+                }
+                if (!replaced) {
+                    fields_.push_back(field);
+                }
+            }
+        }
+    }
+
+    indexed_ = true;
+    return fields_;
+}
+
+ResponseHeader::value_type ResponseHeader::get(size_t index) const {
+    const Field& field = fields()[index];
+    return {raw_.substr(field.name_offset, field.name_length), raw_.substr(field.value_offset, field.value_length)};
+}
+
+size_t ResponseHeader::indexOf(std::string_view name) const {
+    const std::vector<Field>& all_fields = fields();
+    const size_t hash = hashCaseInsensitive(name);
+    for (size_t i = 0; i < all_fields.size(); i++) {
+        if (all_fields[i].name_hash == hash && equalsCaseInsensitive(raw_.substr(all_fields[i].name_offset, all_fields[i].name_length), name)) {
+            return i;
+        }
+    }
+    return all_fields.size();
+}
+
+} // namespace cpr
@@ -0,0 +1,137 @@
+#include "cpr/response_sink.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace cpr {
+
+size_t BufferSink::Write(std::string_view data) {
+    const size_t count = std::min(data.size(), capacity_ - size_);
+    if (count < data.size()) {
+        overflown_ = true;
+    }
+    if (count > 0) {
+        // NOLINTNEXTLINE (cppcoreguidelines-pro-bounds-pointer-arithmetic)
+        std::memcpy(data_ + size_, data.data(), count);
+        size_ += count;
+    }
+    return count;
+}
+
+void BufferSink::Clear() {
+    size_ = 0;
+    overflown_ = false;
+}
+
+size_t BufferSink::GetSize() const {
+    return size_;
+}
+
+std::string BufferSink::GetString() const {
+    return std::string{GetView()};
+}
+
+std::string_view BufferSink::GetView() const {
+    return {data_, size_};
+}
+
+bool BufferSink::IsOverflown() const {
+    return overflown_;
+}
+
+ChunkedSink::ChunkedSink(size_t chunk_size) : chunk_size_(chunk_size) {
+    if (chunk_size_ == 0) {
+        throw std::invalid_argument("The chunk size of a ChunkedSink has to be greater than zero.");
+    }
+}
+
+size_t ChunkedSink::Write(std::string_view data) {
+    const size_t total = data.size();
+    while (!data.empty()) {
+        if (used_chunks_ == 0 || chunks_[used_chunks_ - 1].size() >= chunk_size_) {
+            // The current chunk is full, continue with the next one and reuse it if it already exists
+            if (used_chunks_ == chunks_.size()) {
+                chunks_.emplace_back().reserve(chunk_size_);
+            }
+            used_chunks_++;
+        }
+
+        std::string& chunk = chunks_[used_chunks_ - 1];
+        const size_t count = std::min(data.size(), chunk_size_ - chunk.size());
+        chunk.append(data.data(), count);
+        data.remove_prefix(count);
+    }
+    size_ += total;
+    return total;
+}
+
+void ChunkedSink::Reserve(size_t size) {
+    // Allocate all chunks upfront, so Write(...) does not have to allocate at all
+    const size_t required_chunks = (size + chunk_size_ - 1) / chunk_size_;
+    chunks_.reserve(required_chunks);
+    while (chunks_.size() < required_chunks) {
+        chunks_.emplace_back().reserve(chunk_size_);
+    }
+}
+
+void ChunkedSink::Clear() {
+    for (size_t i = 0; i < used_chunks_; i++) {
+        chunks_[i].clear();
+    }
+    used_chunks_ = 0;
+    size_ = 0;
+}
+
+size_t ChunkedSink::GetSize() const {
+    return size_;
+}
+
+std::string ChunkedSink::GetString() const {
+    std::string result;
+    result.reserve(size_);
+    for (size_t i = 0; i < used_chunks_; i++) {
+        result.append(chunks_[i]);
+    }
+    return result;
+}
+
+std::vector<std::string_view> ChunkedSink::GetChunks() const {
+    std::vector<std::string_view> result;
+    result.reserve(used_chunks_);
+    for (size_t i = 0; i < used_chunks_; i++) {
+        result.emplace_back(chunks_[i]);
+    }
+    return result;
+}
+
+size_t PmrSink::Write(std::string_view data) {
+    body_.append(data.data(), data.size());
+    return data.size();
+}
+
+void PmrSink::Reserve(size_t size) {
+    body_.reserve(size);
+}
+
+void PmrSink::Clear() {
+    body_.clear();
+}
+
+size_t PmrSink::GetSize() const {
+    return body_.size();
+}
+
+std::string PmrSink::GetString() const {
+    return std::string{body_};
+}
+
+const std::pmr::string& PmrSink::GetBody() const {
+    return body_;
+}
+
+} // namespace cpr
@@ -0,0 +1,228 @@
+#include "cpr/resumable_download.h"
+
+#include <algorithm>
+#include <charconv>
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <utility>
+#include <vector>
+
+#include <curl/curl.h>
+
+#include "cpr/cprtypes.h"
+#include "cpr/filesystem.h"
+#include "cpr/response_header.h"
+#include "cpr/util.h"
+
+namespace cpr {
+
+namespace {
+std::optional<cpr_off_t> parseOffset(std::string_view value) {
+    cpr_off_t offset{0};
+    const char* end = value.data() + value.size(); // NOLINT (cppcoreguidelines-pro-bounds-pointer-arithmetic)
+    const std::from_chars_result result = std::from_chars(value.data(), end, offset);
+    if (result.ec != std::errc() || result.ptr != end || offset < 0) {
+        return std::nullopt;
+    }
+    return offset;
+}
+
+/**
+ * Cuts the file down to the given size, so a FileSink appending to it continues right behind the checkpoint.
+ * Everything written after the last checkpoint might be incomplete and gets downloaded again.
+ **/
+std::string truncateFile(std::string filepath, cpr_off_t size) {
+    if (size > 0) {
+        std::error_code ec;
+        fs::resize_file(filepath, static_cast<std::uintmax_t>(size), ec);
+    }
+    return filepath;
+}
+} // namespace
+
+std::optional<DownloadCheckpoint> DownloadCheckpoint::Load(const std::string& path) {
+    std::ifstream file(path);
+    if (!file) {
+        return std::nullopt;
+    }
+
+    DownloadCheckpoint checkpoint;
+    std::string line;
+    while (std::getline(file, line)) {
+        const size_t colon = line.find(": ");
+        if (colon == std::string::npos) {
+            return std::nullopt;
+        }
+        const std::string_view name = std::string_view{line}.substr(0, colon);
+        const std::string_view value = std::string_view{line}.substr(colon + 2);
+        if (name == "etag") {
+            checkpoint.etag = value;
+        } else if (name == "last-modified") {
+            checkpoint.last_modified = value;
+        } else if (name == "range") {
+            const size_t dash = value.find('-');
+            const std::optional<cpr_off_t> first = parseOffset(value.substr(0, dash));
+            const std::optional<cpr_off_t> last = dash == std::string_view::npos ? std::nullopt : parseOffset(value.substr(dash + 1));
+            if (!first || !last || *last < *first) {
+                return std::nullopt;
+            }
+            checkpoint.ranges.emplace_back(*first, *last);
+        }
+    }
+    return checkpoint;
+}
+
+bool DownloadCheckpoint::Save(const std::string& path) const {
+    const std::string temp_path = path + ".tmp";
+    {
+        std::ofstream file(temp_path, std::ios::trunc);
+        if (!etag.empty()) {
+            file << "etag: " << etag << '\n';
+        }
+        if (!last_modified.empty()) {
+            file << "last-modified: " << last_modified << '\n';
+        }
+        for (const std::pair<cpr_off_t, cpr_off_t>& range : ranges) {
+            file << "range: " << range.first << '-' << range.second << '\n';
+        }
+        if (!file.flush()) {
+            return false;
+        }
+    }
+    // Renaming replaces the previous checkpoint in one step
+    std::error_code ec;
+    fs::rename(temp_path, path, ec);
+    return !ec;
+}
+
+cpr_off_t DownloadCheckpoint::GetCompletedPrefix() const {
+    std::vector<std::pair<cpr_off_t, cpr_off_t>> sorted{ranges};
+    std::sort(sorted.begin(), sorted.end());
+    cpr_off_t prefix{0};
+    for (const std::pair<cpr_off_t, cpr_off_t>& range : sorted) {
+        if (range.first > prefix) {
+            break;
+        }
+        prefix = std::max(prefix, range.second + 1);
+    }
+    return prefix;
+}
+
+std::string DownloadCheckpoint::GetValidator() const {
+    // Weak ETags must not be used for range requests (RFC 9110, section 13.1.5)
+    if (!etag.empty() && etag.compare(0, 2, "W/") != 0) {
+        return etag;
+    }
+    return last_modified;
+}
+
+namespace util {
+
+CheckpointSink::CheckpointSink(const ResumableDownload& download, DownloadCheckpoint checkpoint, CURL* handle, const std::string* raw_header) : checkpoint_(std::move(checkpoint)), offset_(checkpoint_.GetCompletedPrefix()), file_(truncateFile(download.filepath, offset_), FileSink::DEFAULT_BUFFER_SIZE, false, offset_ > 0), checkpoint_path_(download.GetCheckpointPath()), checkpoint_interval_(download.checkpoint_interval), handle_(handle), raw_header_(raw_header) {}
+
+size_t CheckpointSink::Write(std::string_view data) {
+    if (!started_ && !begin()) {
+        return 0;
+    }
+    if (!writing_) {
+        // The body of an error response does not belong into the file
+        return data.size();
+    }
+    const size_t written = file_.Write(data);
+    unsaved_ += written;
+    if (unsaved_ >= checkpoint_interval_ && !saveCheckpoint()) {
+        return 0;
+    }
+    return written;
+}
+
+void CheckpointSink::Reserve(size_t size) {
+    file_.Reserve(size);
+}
+
+void CheckpointSink::Clear() {
+    file_.Clear();
+    unsaved_ = 0;
+    started_ = false;
+    writing_ = false;
+    restart_required_ = false;
+}
+
+bool CheckpointSink::Flush() {
+    return restart_required_ || saveCheckpoint();
+}
+
+size_t CheckpointSink::GetSize() const {
+    return file_.GetSize();
+}
+
+std::string CheckpointSink::GetString() const {
+    return file_.GetString();
+}
+
+bool CheckpointSink::IsRestartRequired() const {
+    return restart_required_;
+}
+
+bool CheckpointSink::HasWritten() const {
+    return writing_;
+}
+
+bool CheckpointSink::begin() {
+    started_ = true;
+    // NOLINTNEXTLINE (google-runtime-int)
+    long status_code{};
+    curl_easy_getinfo(handle_, CURLINFO_RESPONSE_CODE, &status_code);
+    if (offset_ > 0 && (status_code == 200 || status_code == 416)) {
+        // The 'If-Range' validator did not match anymore, so the whole object got sent instead of the remaining part
+        restart_required_ = true;
+        return false;
+    }
+    // All headers have been received once the body starts
+    const ResponseHeader header{*raw_header_};
+    const std::string_view encoding = header["Content-Encoding"];
+    if (!encoding.empty() && encoding != "identity") {
+        // Offsets of the file would not match the ones of the encoded data the server ranges over
+        return false;
+    }
+    if (offset_ > 0 && status_code == 206) {
+        // Data of any other offset would end up at the wrong position inside the file
+        const std::optional<std::pair<cpr_off_t, cpr_off_t>> range = parseContentRange("Content-Range: " + std::string{header["Content-Range"]});
+        if (!range || range->first != offset_) {
+            return false;
+        }
+    }
+    writing_ = offset_ > 0 ? status_code == 206 : status_code >= 200 && status_code < 300;
+    if (writing_) {
+        if (!header["ETag"].empty() || !header["Last-Modified"].empty()) {
+            checkpoint_.etag = header["ETag"];
+            checkpoint_.last_modified = header["Last-Modified"];
+        }
+    }
+    return true;
+}
+
+bool CheckpointSink::saveCheckpoint() {
+    if (!writing_) {
+        return true;
+    }
+    // Only data already written to the file may be part of the checkpoint
+    if (!file_.Flush()) {
+        return false;
+    }
+    checkpoint_.ranges.clear();
+    if (file_.GetSize() > 0) {
+        checkpoint_.ranges.emplace_back(0, static_cast<cpr_off_t>(file_.GetSize()) - 1);
+    }
+    unsaved_ = 0;
+    return checkpoint_.Save(checkpoint_path_);
+}
+
+} // namespace util
+
+} // namespace cpr
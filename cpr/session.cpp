@@ -1,18 +1,27 @@
 #include "cpr/session.h"
 
+#include <algorithm>
 #include <array>
 #include <atomic>
 #include <cassert>
+#include <chrono>
 #include <cstdint>
 #include <cstdlib>
 #include <cstring>
+#include <exception>
 #include <fstream>
+#include <initializer_list>
 #include <iostream>
+#include <limits>
 #include <memory>
+#include <memory_resource>
 #include <optional>
+#include <random>
 #include <stdexcept>
 #include <string>
 #include <string_view>
+#include <system_error>
+#include <thread>
 #include <type_traits>
 #include <utility>
 #include <variant>
@@ -52,9 +61,12 @@
 #include "cpr/proxyauth.h"
 #include "cpr/range.h"
 #include "cpr/redirect.h"
+#include "cpr/request_compression.h"
 #include "cpr/reserve_size.h"
 #include "cpr/resolve.h"
 #include "cpr/response.h"
+#include "cpr/response_sink.h"
+#include "cpr/resumable_download.h"
 #include "cpr/ssl_options.h"
 #include "cpr/timeout.h"
 #include "cpr/unix_socket.h"
@@ -74,6 +86,28 @@ constexpr long ON = 1L;
 // Ignored here since libcurl reqires a long:
 // NOLINTNEXTLINE(google-runtime-int)
 constexpr long OFF = 0L;
+#if LIBCURL_VERSION_NUM >= 0x073E00 // 7.62.0
+// Default of CURLOPT_UPLOAD_BUFFERSIZE, restored after streamed bodies raised it
+// NOLINTNEXTLINE(google-runtime-int)
+constexpr long DEFAULT_UPLOAD_BUFFER_SIZE = 64L * 1024L;
+#endif
+
+namespace {
+// Concatenates the given parts into a null-terminated string allocated from the given resource
+char* concatenate(std::pmr::memory_resource* resource, std::initializer_list<std::string_view> parts) {
+    size_t size = 1;
+    for (const std::string_view part : parts) {
+        size += part.size();
+    }
+    char* result = static_cast<char*>(resource->allocate(size, alignof(char)));
+    char* end = result;
+    for (const std::string_view part : parts) {
+        end = std::copy(part.begin(), part.end(), end);
+    }
+    *end = '\0';
+    return result;
+}
+} // namespace
 
 CURLcode Session::DoEasyPerform() {
     if (isUsedInMultiPerform) {
@@ -84,40 +118,67 @@ CURLcode Session::DoEasyPerform() {
 }
 
 void Session::prepareHeader() {
-    curl_slist* chunk = nullptr;
-    for (const std::pair<const std::string, std::string>& item : header_) {
-        std::string header_string = item.first;
-        if (item.second.empty()) {
-            header_string += ";";
-        } else {
-            header_string += ": " + item.second;
+    curl_slist_free_all(curl_->chunk);
+    curl_->chunk = nullptr;
+    arenaHeader_ = nullptr;
+    arenaHeaderTail_ = nullptr;
+
+    if (requestArena_) {
+        // Lines and list nodes stay in the arena until the next request, so none of them gets allocated or freed on its own
+        std::pmr::memory_resource* resource = requestArena_->GetResource();
+        for (const std::pair<const std::string, std::string>& item : header_) {
+            appendArenaHeader(item.second.empty() ? concatenate(resource, {item.first, ";"}) : concatenate(resource, {item.first, ": ", item.second}));
         }
-
-        curl_slist* temp = curl_slist_append(chunk, header_string.c_str());
-        if (temp) {
-            chunk = temp;
+    } else {
+        // curl copies each line, so a single buffer can be reused for all of them
+        std::string header_string;
+        for (const std::pair<const std::string, std::string>& item : header_) {
+            header_string.assign(item.first);
+            if (item.second.empty()) {
+                header_string += ";";
+            } else {
+                header_string.append(": ").append(item.second);
+            }
+            appendHeader(header_string.c_str());
         }
     }
 
     // Set the chunked transfer encoding in case it does not already exist:
     if (chunkedTransferEncoding_ && header_.find("Transfer-Encoding") == header_.end()) {
-        curl_slist* temp = curl_slist_append(chunk, "Transfer-Encoding:chunked");
-        if (temp) {
-            chunk = temp;
-        }
+        appendHeader("Transfer-Encoding:chunked");
     }
 
     // libcurl would prepare the header "Expect: 100-continue" by default when uploading files larger than 1 MB.
     // Here we would like to disable this feature:
-    curl_slist* temp = curl_slist_append(chunk, "Expect:");
+    appendHeader("Expect:");
+}
+
+void Session::appendHeader(const char* line) {
+    if (requestArena_) {
+        appendArenaHeader(concatenate(requestArena_->GetResource(), {line}));
+        return;
+    }
+    curl_slist* temp = curl_slist_append(curl_->chunk, line);
     if (temp) {
-        chunk = temp;
+        curl_->chunk = temp;
     }
+}
 
-    curl_easy_setopt(curl_->handle, CURLOPT_HTTPHEADER, chunk);
+void Session::appendArenaHeader(char* line) {
+    // libcurl only reads the list, so its nodes do not have to come from curl_slist_append(...)
+    auto* node = static_cast<curl_slist*>(requestArena_->GetResource()->allocate(sizeof(curl_slist), alignof(curl_slist)));
+    node->data = line;
+    node->next = nullptr;
+    if (arenaHeaderTail_) {
+        arenaHeaderTail_->next = node;
+    } else {
+        arenaHeader_ = node;
+    }
+    arenaHeaderTail_ = node;
+}
 
-    curl_slist_free_all(curl_->chunk);
-    curl_->chunk = chunk;
+void Session::applyHeader() {
+    curl_easy_setopt(curl_->handle, CURLOPT_HTTPHEADER, requestArena_ ? arenaHeader_ : curl_->chunk);
 }
 
 void Session::prepareProxy() {
@@ -161,6 +222,13 @@ Session::Session() : curl_(new CurlHolder()) {
     first_interceptor_ = interceptors_.end();
 }
 
+Session::~Session() {
+    // Responses may keep the handle alive, detach it so the pool or jar can be released together with its share
+    if (connectionPool_ || cookieJar_) {
+        curl_easy_setopt(curl_->handle, CURLOPT_SHARE, nullptr);
+    }
+}
+
 Response Session::makeDownloadRequest() {
     const std::optional<Response> r = intercept();
     if (r.has_value()) {
@@ -175,16 +243,32 @@ Response Session::makeDownloadRequest() {
 void Session::prepareCommonShared() {
     assert(curl_->handle);
 
+    // Responses of previous transfers can no longer read their fields from the handle
+    curl_->generation++;
+
+    // Free all allocations of the previous request at once
+    if (requestArena_) {
+        requestArena_->Release();
+    }
+
     // Set Header:
     prepareHeader();
 
     // URL parameter:
-    const std::string parametersContent = parameters_.GetContent(*curl_);
-    if (!parametersContent.empty()) {
-        const Url new_url{url_ + "?" + parametersContent};
-        curl_easy_setopt(curl_->handle, CURLOPT_URL, new_url.c_str());
+    if (requestArena_) {
+        // The encoded parameters and the URL built from them stay in the arena as well
+        std::pmr::memory_resource* resource = requestArena_->GetResource();
+        const std::pmr::string parametersContent = parameters_.GetContent(*curl_, resource);
+        const char* url = parametersContent.empty() ? url_.c_str() : concatenate(resource, {url_.str(), "?", parametersContent});
+        curl_easy_setopt(curl_->handle, CURLOPT_URL, url);
     } else {
-        curl_easy_setopt(curl_->handle, CURLOPT_URL, url_.c_str());
+        const std::string parametersContent = parameters_.GetContent(*curl_);
+        if (!parametersContent.empty()) {
+            const Url new_url{url_ + "?" + parametersContent};
+            curl_easy_setopt(curl_->handle, CURLOPT_URL, new_url.c_str());
+        } else {
+            curl_easy_setopt(curl_->handle, CURLOPT_URL, url_.c_str());
+        }
     }
 
     // Proxy:
@@ -200,6 +284,7 @@ void Session::prepareCommonShared() {
         }
     }
 
+    decodeContent_ = false;
 #if LIBCURL_VERSION_NUM >= 0x071506 // 7.21.6
     if (acceptEncoding_.empty()) {
         // Enable all supported built-in compressions
@@ -207,16 +292,35 @@ void Session::prepareCommonShared() {
     } else if (acceptEncoding_.disabled()) {
         // Disable curl adding the 'Accept-Encoding' header
         curl_easy_setopt(curl_->handle, CURLOPT_ACCEPT_ENCODING, nullptr);
+    } else if (acceptEncoding_.requiresContentDecoder()) {
+        // curl would reject encodings it does not know, so it passes the body on as it is and cpr decodes it
+        decodeContent_ = true;
+        curl_easy_setopt(curl_->handle, CURLOPT_ACCEPT_ENCODING, nullptr);
+        if (header_.find("Accept-Encoding") == header_.end()) {
+            const std::string accept_encoding = "Accept-Encoding: " + acceptEncoding_.getString();
+            appendHeader(accept_encoding.c_str());
+        }
     } else {
         curl_easy_setopt(curl_->handle, CURLOPT_ACCEPT_ENCODING, acceptEncoding_.getString().c_str());
     }
 #endif
+    curl_easy_setopt(curl_->handle, CURLOPT_HTTP_CONTENT_DECODING, decodeContent_ ? OFF : ON);
 
     curl_->error[0] = '\0';
 
+    // Reuse buffers of previous responses instead of growing new ones
+    if (bufferPool_) {
+        if (response_string_.capacity() <= std::string{}.capacity()) {
+            response_string_ = bufferPool_->Acquire();
+        }
+        if (header_string_.capacity() <= std::string{}.capacity()) {
+            header_string_ = bufferPool_->Acquire();
+        }
+    }
+
     // Clear the response
     response_string_.clear();
-    if (response_string_reserve_size_ > 0) {
+    if (response_string_reserve_size_ > 0 && !responseSink_) {
         response_string_.reserve(response_string_reserve_size_);
     }
 
@@ -233,16 +337,63 @@ void Session::prepareCommon() {
     // Set Content:
     prepareBodyPayloadOrMultipart();
 
+    // The body may have added header lines, so the list is complete now
+    applyHeader();
+
     if (!cbs_->writecb_.callback && !cbs_->ssecb_.callback) {
-        curl_easy_setopt(curl_->handle, CURLOPT_WRITEFUNCTION, cpr::util::writeFunction);
-        curl_easy_setopt(curl_->handle, CURLOPT_WRITEDATA, &response_string_);
+        if (responseSink_) {
+            responseSink_->Clear();
+            if (response_string_reserve_size_ > 0) {
+                responseSink_->Reserve(response_string_reserve_size_);
+            }
+            curl_easy_setopt(curl_->handle, CURLOPT_WRITEFUNCTION, cpr::util::writeSinkFunction);
+            curl_easy_setopt(curl_->handle, CURLOPT_WRITEDATA, responseSink_.get());
+        } else {
+            curl_easy_setopt(curl_->handle, CURLOPT_WRITEFUNCTION, cpr::util::writeFunction);
+            curl_easy_setopt(curl_->handle, CURLOPT_WRITEDATA, &response_string_);
+        }
     }
 
     header_string_.clear();
     if (!cbs_->headercb_.callback) {
-        curl_easy_setopt(curl_->handle, CURLOPT_HEADERFUNCTION, cpr::util::writeFunction);
-        curl_easy_setopt(curl_->handle, CURLOPT_HEADERDATA, &header_string_);
+        if (auto_reserve_max_size_ > 0 && !cbs_->writecb_.callback && !cbs_->ssecb_.callback) {
+            // Reserve space for the body as soon as the 'Content-Length' header arrives
+            contentLengthReserve_ = util::ContentLengthReserve{&header_string_, &response_string_, responseSink_.get(), auto_reserve_max_size_};
+            curl_easy_setopt(curl_->handle, CURLOPT_HEADERFUNCTION, cpr::util::writeHeaderReserveFunction);
+            curl_easy_setopt(curl_->handle, CURLOPT_HEADERDATA, &contentLengthReserve_);
+        } else {
+            curl_easy_setopt(curl_->handle, CURLOPT_HEADERFUNCTION, cpr::util::writeFunction);
+            curl_easy_setopt(curl_->handle, CURLOPT_HEADERDATA, &header_string_);
+        }
     }
+
+    if (decodeContent_) {
+        if (cbs_->ssecb_.callback) {
+            prepareContentDecoder([this](char* data, size_t size) { return cpr::util::writeSSEFunction(data, 1, size, &cbs_->ssecb_); });
+        } else if (cbs_->writecb_.callback) {
+            prepareContentDecoder([this](char* data, size_t size) { return cpr::util::writeUserFunction(data, 1, size, &cbs_->writecb_); });
+        } else if (responseSink_) {
+            prepareContentDecoder([this](char* data, size_t size) { return cpr::util::writeSinkFunction(data, 1, size, responseSink_.get()); });
+        } else {
+            prepareContentDecoder([this](char* data, size_t size) { return cpr::util::writeFunction(data, 1, size, &response_string_); });
+        }
+    } else if (contentDecoder_) {
+        // Callbacks only get set once, so restore the one the decoder replaced
+        contentDecoder_.reset();
+        if (cbs_->ssecb_.callback) {
+            curl_easy_setopt(curl_->handle, CURLOPT_WRITEFUNCTION, cpr::util::writeSSEFunction);
+            curl_easy_setopt(curl_->handle, CURLOPT_WRITEDATA, &cbs_->ssecb_);
+        } else if (cbs_->writecb_.callback) {
+            curl_easy_setopt(curl_->handle, CURLOPT_WRITEFUNCTION, cpr::util::writeUserFunction);
+            curl_easy_setopt(curl_->handle, CURLOPT_WRITEDATA, &cbs_->writecb_);
+        }
+    }
+}
+
+void Session::prepareContentDecoder(std::function<size_t(char* data, size_t size)> write) {
+    contentDecoder_ = std::make_unique<util::ContentDecoder>(curl_->handle, &header_string_, std::move(write));
+    curl_easy_setopt(curl_->handle, CURLOPT_WRITEFUNCTION, cpr::util::writeDecoderFunction);
+    curl_easy_setopt(curl_->handle, CURLOPT_WRITEDATA, contentDecoder_.get());
 }
 
 void Session::prepareCommonDownload() {
@@ -250,11 +401,17 @@ void Session::prepareCommonDownload() {
 
     // Everything else:
     prepareCommonShared();
+    applyHeader();
 
     header_string_.clear();
     if (cbs_->headercb_.callback) {
         curl_easy_setopt(curl_->handle, CURLOPT_HEADERFUNCTION, cpr::util::headerUserFunction);
         curl_easy_setopt(curl_->handle, CURLOPT_HEADERDATA, &cbs_->headercb_);
+    } else if (downloadSink_) {
+        // Let the sink preallocate the whole body as soon as the 'Content-Length' header arrives
+        contentLengthReserve_ = util::ContentLengthReserve{&header_string_, nullptr, downloadSink_.get(), std::numeric_limits<size_t>::max()};
+        curl_easy_setopt(curl_->handle, CURLOPT_HEADERFUNCTION, cpr::util::writeHeaderReserveFunction);
+        curl_easy_setopt(curl_->handle, CURLOPT_HEADERDATA, &contentLengthReserve_);
     } else {
         curl_easy_setopt(curl_->handle, CURLOPT_HEADERFUNCTION, cpr::util::writeFunction);
         curl_easy_setopt(curl_->handle, CURLOPT_HEADERDATA, &header_string_);
@@ -267,11 +424,101 @@ Response Session::makeRequest() {
         return r.value();
     }
 
-    const CURLcode curl_error = DoEasyPerform();
+    CURLcode curl_error = DoEasyPerform();
+    if (sseReconnect_ && cbs_->ssecb_.callback) {
+        curl_error = reconnectServerSentEvents(curl_error);
+    }
 
     return Complete(curl_error);
 }
 
+CURLcode Session::reconnectServerSentEvents(CURLcode curl_error) {
+    const auto initialHeader = header_.find("Last-Event-ID");
+    const std::optional<std::string> initialLastEventId = initialHeader != header_.end() ? std::make_optional(initialHeader->second) : std::nullopt;
+    using Rep = std::chrono::milliseconds::rep;
+    const std::chrono::milliseconds maxRetry = std::max(sseReconnect_->max_retry, std::chrono::milliseconds::zero());
+    std::mt19937 random{std::random_device{}()};
+    size_t failedAttempts = 0;
+    while (true) {
+        // NOLINTNEXTLINE (google-runtime-int)
+        long status_code{0};
+        curl_easy_getinfo(curl_->handle, CURLINFO_RESPONSE_CODE, &status_code);
+        // Stopped by a callback or rejected by the server, e.g. using 204 No Content to end the stream
+        if (curl_error == CURLE_WRITE_ERROR || curl_error == CURLE_ABORTED_BY_CALLBACK || (status_code != 0 && status_code != 200)) {
+            break;
+        }
+        if (status_code == 200) {
+            failedAttempts = 0;
+        }
+        if (failedAttempts >= sseReconnect_->max_attempts) {
+            break;
+        }
+
+        // The reconnection time of the server gets clamped in its unsigned type, so it can not turn negative
+        const std::optional<size_t> serverRetry = cbs_->ssecb_.retry();
+        const std::chrono::milliseconds retry = serverRetry.has_value() ? std::chrono::milliseconds{static_cast<Rep>(std::min(*serverRetry, static_cast<size_t>(maxRetry.count())))} : std::clamp(sseReconnect_->retry, std::chrono::milliseconds::zero(), maxRetry);
+        // Back off exponentially while the server can not be reached, doubling only while the result stays below maxRetry
+        std::chrono::milliseconds delay = retry;
+        for (size_t i = 0; i < failedAttempts && delay > std::chrono::milliseconds::zero() && delay < maxRetry; i++) {
+            delay = delay > maxRetry / 2 ? maxRetry : delay * 2;
+        }
+        const Rep jitter = std::min(delay.count() / 2, std::numeric_limits<Rep>::max() - delay.count());
+        delay += std::chrono::milliseconds{std::uniform_int_distribution<Rep>{0, jitter}(random)};
+        // max_retry also bounds the jitter
+        delay = std::min(delay, maxRetry);
+        if (!waitForReconnect(delay)) {
+            curl_error = CURLE_ABORTED_BY_CALLBACK;
+            break;
+        }
+        failedAttempts++;
+
+        cbs_->ssecb_.discardEvent();
+        if (const std::optional<std::string>& lastEventId = cbs_->ssecb_.lastEventId()) {
+            // An empty ID field resets the ID, so none gets sent anymore
+            if (lastEventId->empty()) {
+                header_.erase("Last-Event-ID");
+            } else {
+                header_["Last-Event-ID"] = *lastEventId;
+            }
+        }
+        prepareCommon();
+        curl_error = DoEasyPerform();
+    }
+
+    if (initialLastEventId.has_value()) {
+        header_["Last-Event-ID"] = *initialLastEventId;
+    } else {
+        header_.erase("Last-Event-ID");
+    }
+    return curl_error;
+}
+
+bool Session::waitForReconnect(std::chrono::milliseconds delay) {
+    // Nothing notifies about a cancellation, so check it (and the progress callback) like libcurl does during a transfer
+    constexpr std::chrono::milliseconds pollInterval{50};
+    const std::chrono::steady_clock::time_point deadline = std::chrono::steady_clock::now() + delay;
+    while (true) {
+        const bool proceed = isCancellable ? cbs_->cancellationcb_(0, 0, 0, 0) : cbs_->progresscb_(0, 0, 0, 0);
+        if (!proceed) {
+            return false;
+        }
+        const std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
+        if (now >= deadline) {
+            return true;
+        }
+        std::this_thread::sleep_for(std::min<std::chrono::steady_clock::duration>(deadline - now, pollInterval));
+    }
+}
+
+void Session::SetRequestCompression(const RequestCompression& compression) {
+    // Creating a compressor checks the settings right away instead of failing on the next request
+    if (compression.method != RequestCompressionMethod::identity) {
+        const util::Compressor compressor{compression};
+    }
+    requestCompression_ = compression.method == RequestCompressionMethod::identity ? std::nullopt : std::make_optional(compression);
+    compressedContent_.reset();
+}
+
 void Session::SetLimitRate(const LimitRate& limit_rate) {
     curl_easy_setopt(curl_->handle, CURLOPT_MAX_RECV_SPEED_LARGE, limit_rate.downrate);
     curl_easy_setopt(curl_->handle, CURLOPT_MAX_SEND_SPEED_LARGE, limit_rate.uprate);
@@ -283,21 +530,22 @@ const Content& Session::GetContent() const {
 
 void Session::RemoveContent() {
     // inverse function to prepareBodyPayloadOrMultipart()
-    if (std::holds_alternative<cpr::Payload>(content_) || std::holds_alternative<cpr::Body>(content_)) {
-        // set default values, so curl does not send a body in subsequent requests
-        curl_easy_setopt(curl_->handle, CURLOPT_POSTFIELDSIZE_LARGE, -1);
-        curl_easy_setopt(curl_->handle, CURLOPT_COPYPOSTFIELDS, nullptr);
-    } else if (std::holds_alternative<cpr::Multipart>(content_)) {
+    if (std::holds_alternative<cpr::Multipart>(content_)) {
         if (curl_->multipart) {
             // remove multipart data
             curl_mime_free(curl_->multipart);
             curl_->multipart = nullptr;
         }
-    } else if (std::holds_alternative<cpr::BodyView>(content_)) {
+        multipartReaders_.clear();
+        multipartPrepared_ = false;
+    } else if (!std::holds_alternative<std::monostate>(content_)) {
         // set default values, so curl does not send a body in subsequent requests
-        curl_easy_setopt(curl_->handle, CURLOPT_POSTFIELDSIZE_LARGE, -1);
+        curl_easy_setopt(curl_->handle, CURLOPT_POSTFIELDSIZE_LARGE, static_cast<curl_off_t>(-1));
         curl_easy_setopt(curl_->handle, CURLOPT_POSTFIELDS, nullptr);
     }
+    resetBodyStream();
+    payloadContent_.reset();
+    compressedContent_.reset();
     content_ = std::monostate{};
 }
 
@@ -328,6 +576,10 @@ void Session::SetServerSentEventCallback(const ServerSentEventCallback& sse) {
     curl_easy_setopt(curl_->handle, CURLOPT_WRITEDATA, &cbs_->ssecb_);
 }
 
+void Session::SetServerSentEventReconnect(const ServerSentEventReconnect& reconnect) {
+    sseReconnect_ = reconnect;
+}
+
 void Session::SetProgressCallback(const ProgressCallback& progress) {
     cbs_->progresscb_ = progress;
     if (isCancellable) {
@@ -405,10 +657,23 @@ void Session::SetConnectTimeout(const ConnectTimeout& timeout) {
 }
 
 void Session::SetConnectionPool(const ConnectionPool& pool) {
+    // Replacing the share of the jar would silently stop storing cookies in it
+    if (cookieJar_ && !cookieJar_->IsSharedWith(pool)) {
+        throw std::invalid_argument("Unable to set a connection pool the cookie jar of the session has not been created from");
+    }
+    connectionPool_.emplace(pool);
     CURL* curl = curl_->handle;
     pool.SetupHandler(curl);
 }
 
+void Session::SetBufferPool(const BufferPool& pool) {
+    bufferPool_ = std::make_shared<BufferPool>(pool);
+}
+
+void Session::SetRequestArena(const RequestArena& arena) {
+    requestArena_ = std::make_shared<RequestArena>(arena);
+}
+
 void Session::SetAuth(const Authentication& auth) {
     // Ignore here since this has been defined by libcurl.
     switch (auth.GetAuthMode()) {
@@ -445,10 +710,14 @@ void Session::SetUserAgent(const UserAgent& ua) {
 
 void Session::SetPayload(const Payload& payload) {
     content_ = payload;
+    payloadContent_.reset();
+    compressedContent_.reset();
 }
 
 void Session::SetPayload(Payload&& payload) {
     content_ = std::move(payload);
+    payloadContent_.reset();
+    compressedContent_.reset();
 }
 
 void Session::SetProxies(const Proxies& proxies) {
@@ -469,10 +738,12 @@ void Session::SetProxyAuth(const ProxyAuthentication& proxy_auth) {
 
 void Session::SetMultipart(const Multipart& multipart) {
     content_ = multipart;
+    multipartPrepared_ = false;
 }
 
 void Session::SetMultipart(Multipart&& multipart) {
     content_ = std::move(multipart);
+    multipartPrepared_ = false;
 }
 
 void Session::SetRedirect(const Redirect& redirect) {
@@ -495,22 +766,59 @@ void Session::SetRedirect(const Redirect& redirect) {
 }
 
 void Session::SetCookies(const Cookies& cookies) {
-    curl_easy_setopt(curl_->handle, CURLOPT_COOKIELIST, "ALL");
-    curl_easy_setopt(curl_->handle, CURLOPT_COOKIE, cookies.GetEncoded(*curl_).c_str());
+    // Dropping the stored cookies would empty the jar for all sessions sharing it
+    if (!cookieJar_) {
+        curl_easy_setopt(curl_->handle, CURLOPT_COOKIELIST, "ALL");
+    }
+    curl_easy_setopt(curl_->handle, CURLOPT_COOKIE, cookies.GetEncoded().c_str());
+}
+
+void Session::SetResponseFields(const ResponseFields& fields) {
+    responseFields_ = fields;
+}
+
+void Session::SetDetachResponse(const DetachResponse& detach) {
+    detachResponse_ = detach;
+}
+
+void Session::SetCookieEngine(const CookieEngine& cookie_engine) {
+    cookieEngine_ = cookie_engine.enabled;
+    // Passing nullptr disables the cookie engine and drops all cookies received so far
+    curl_easy_setopt(curl_->handle, CURLOPT_COOKIEFILE, cookieEngine_ ? "" : nullptr);
+}
+
+void Session::SetCookieJar(const CookieJar& jar) {
+    // Replacing the share of the pool would silently stop sharing connections
+    if (connectionPool_ && !jar.IsSharedWith(*connectionPool_)) {
+        throw std::invalid_argument("Unable to set a cookie jar not created from the connection pool of the session");
+    }
+    cookieJar_.emplace(jar);
+    jar.SetupHandler(curl_->handle);
 }
 
 void Session::SetBody(const Body& body) {
     content_ = body;
+    compressedContent_.reset();
 }
 
 void Session::SetBody(Body&& body) {
     content_ = std::move(body);
+    compressedContent_.reset();
 }
 
 // cppcheck-suppress passedByValue
+void Session::SetFileBody(const FileBody& body) {
+    content_ = body;
+}
+
+void Session::SetPayloadStream(const PayloadStream& payload) {
+    content_ = payload;
+}
+
 void Session::SetBodyView(BodyView body) {
     static_assert(std::is_trivially_copyable_v<BodyView>, "BodyView expected to be trivially copyable otherwise will need some std::move across codebase");
     content_ = body;
+    compressedContent_.reset();
 }
 
 void Session::SetLowSpeed(const LowSpeed& low_speed) {
@@ -720,19 +1028,23 @@ void Session::SetHttpVersion(const HttpVersion& version) {
 }
 
 void Session::SetRange(const Range& range) {
-    const std::string range_str = range.str();
-    curl_easy_setopt(curl_->handle, CURLOPT_RANGE, range_str.c_str());
+    range_ = range.str();
+    curl_easy_setopt(curl_->handle, CURLOPT_RANGE, range_.c_str());
 }
 
 void Session::SetMultiRange(const MultiRange& multi_range) {
-    const std::string multi_range_str = multi_range.str();
-    curl_easy_setopt(curl_->handle, CURLOPT_RANGE, multi_range_str.c_str());
+    range_ = multi_range.str();
+    curl_easy_setopt(curl_->handle, CURLOPT_RANGE, range_.c_str());
 }
 
 void Session::SetReserveSize(const ReserveSize& reserve_size) {
     ResponseStringReserve(reserve_size.size);
 }
 
+void Session::SetAutoReserveSize(const AutoReserveSize& auto_reserve_size) {
+    auto_reserve_max_size_ = auto_reserve_size.max_size;
+}
+
 void Session::SetAcceptEncoding(const AcceptEncoding& accept_encoding) {
     acceptEncoding_ = accept_encoding;
 }
@@ -741,6 +1053,10 @@ void Session::SetAcceptEncoding(AcceptEncoding&& accept_encoding) {
     acceptEncoding_ = std::move(accept_encoding);
 }
 
+void Session::SetResponseSink(const std::shared_ptr<ResponseSink>& sink) {
+    responseSink_ = sink;
+}
+
 cpr_off_t Session::GetDownloadFileLength() {
     cpr_off_t downloadFileLength = -1;
     curl_easy_setopt(curl_->handle, CURLOPT_URL, url_.c_str());
@@ -779,6 +1095,55 @@ Response Session::Download(std::ofstream& file) {
     return makeDownloadRequest();
 }
 
+Response Session::Download(const std::shared_ptr<ResponseSink>& sink) {
+    PrepareDownload(sink);
+    return makeDownloadRequest();
+}
+
+Response Session::Download(const ResumableDownload& download) {
+    DownloadCheckpoint checkpoint = DownloadCheckpoint::Load(download.GetCheckpointPath()).value_or(DownloadCheckpoint{});
+    // Without a validator or the data it refers to, there is no way to continue safely
+    std::error_code ec;
+    const std::uintmax_t file_size = fs::file_size(download.filepath, ec);
+    if (checkpoint.GetValidator().empty() || ec || file_size < static_cast<std::uintmax_t>(checkpoint.GetCompletedPrefix())) {
+        checkpoint = DownloadCheckpoint{};
+    }
+
+    // The range, validator and encoding of the download replace the ones set by the caller only for its duration
+    const Header header = header_;
+    const AcceptEncoding accept_encoding = acceptEncoding_;
+    while (true) {
+        const cpr_off_t offset = checkpoint.GetCompletedPrefix();
+        const std::shared_ptr<util::CheckpointSink> sink = std::make_shared<util::CheckpointSink>(download, checkpoint, curl_->handle, &header_string_);
+        // Ranges refer to the bytes sent, so an encoded body (e.g. served by 'gzip_static' of nginx) must not get decoded on the way.
+        // Disabling AcceptEncoding also keeps curl from decoding, which leaves rejecting an encoded body up to the sink.
+        header_["Accept-Encoding"] = "identity";
+        acceptEncoding_ = AcceptEncoding{AcceptEncodingMethods::disabled};
+        if (offset > 0) {
+            header_["If-Range"] = checkpoint.GetValidator();
+            const std::string range = Range{offset, std::nullopt}.str();
+            curl_easy_setopt(curl_->handle, CURLOPT_RANGE, range.c_str());
+        } else {
+            header_.erase("If-Range");
+            curl_easy_setopt(curl_->handle, CURLOPT_RANGE, nullptr);
+        }
+        Response response = Download(sink);
+        header_ = header;
+        acceptEncoding_ = accept_encoding;
+        curl_easy_setopt(curl_->handle, CURLOPT_RANGE, range_.empty() ? nullptr : range_.c_str());
+
+        if (offset > 0 && (sink->IsRestartRequired() || response.status_code == 416)) {
+            // The object changed since the checkpoint got created
+            checkpoint = DownloadCheckpoint{};
+            continue;
+        }
+        if (!response.error && sink->HasWritten()) {
+            fs::remove(download.GetCheckpointPath(), ec);
+        }
+        return response;
+    }
+}
+
 Response Session::Get() {
     PrepareGet();
     return makeRequest();
@@ -834,6 +1199,10 @@ AsyncResponse Session::DownloadAsync(std::ofstream& file) {
     return async([shared_this = GetSharedPtrFromThis(), &file]() { return shared_this->Download(file); });
 }
 
+AsyncResponse Session::DownloadAsync(const std::shared_ptr<ResponseSink>& sink) {
+    return async([shared_this = GetSharedPtrFromThis(), sink]() { return shared_this->Download(sink); });
+}
+
 AsyncResponse Session::HeadAsync() {
     return async([shared_this = GetSharedPtrFromThis()]() { return shared_this->Head(); });
 }
@@ -888,6 +1257,8 @@ void Session::PrepareHead() {
     curl_easy_setopt(curl_->handle, CURLOPT_NOBODY, 1L);
     curl_easy_setopt(curl_->handle, CURLOPT_CUSTOMREQUEST, nullptr);
     prepareCommon();
+    // HEAD responses carry the 'Content-Length' of a body that never arrives
+    contentLengthReserve_.max_size = 0;
 }
 
 void Session::PrepareOptions() {
@@ -937,7 +1308,26 @@ void Session::PrepareDownload(std::ofstream& file) {
     curl_easy_setopt(curl_->handle, CURLOPT_WRITEDATA, &file);
     curl_easy_setopt(curl_->handle, CURLOPT_CUSTOMREQUEST, nullptr);
 
+    downloadSink_.reset();
     prepareCommonDownload();
+    if (decodeContent_) {
+        prepareContentDecoder([&file](char* data, size_t size) { return cpr::util::writeFileFunction(data, 1, size, &file); });
+    }
+}
+
+void Session::PrepareDownload(const std::shared_ptr<ResponseSink>& sink) {
+    curl_easy_setopt(curl_->handle, CURLOPT_NOBODY, 0L);
+    curl_easy_setopt(curl_->handle, CURLOPT_HTTPGET, 1);
+    curl_easy_setopt(curl_->handle, CURLOPT_WRITEFUNCTION, cpr::util::writeSinkFunction);
+    curl_easy_setopt(curl_->handle, CURLOPT_WRITEDATA, sink.get());
+    curl_easy_setopt(curl_->handle, CURLOPT_CUSTOMREQUEST, nullptr);
+
+    sink->Clear();
+    downloadSink_ = sink;
+    prepareCommonDownload();
+    if (decodeContent_) {
+        prepareContentDecoder([sink](char* data, size_t size) { return cpr::util::writeSinkFunction(data, 1, size, sink.get()); });
+    }
 }
 
 void Session::PrepareDownload(const WriteCallback& write) {
@@ -947,17 +1337,42 @@ void Session::PrepareDownload(const WriteCallback& write) {
 
     SetWriteCallback(write);
 
+    downloadSink_.reset();
     prepareCommonDownload();
+    if (decodeContent_) {
+        prepareContentDecoder([this](char* data, size_t size) { return cpr::util::writeUserFunction(data, 1, size, &cbs_->writecb_); });
+    }
 }
 
-Response Session::Complete(CURLcode curl_error) {
+Cookies Session::getResponseCookies() {
+    if (!cookieEngine_ || cookieJar_) {
+        return Cookies{};
+    }
     curl_slist* raw_cookies{nullptr};
     curl_easy_getinfo(curl_->handle, CURLINFO_COOKIELIST, &raw_cookies);
-    Cookies cookies = util::parseCookies(raw_cookies);
-    curl_slist_free_all(raw_cookies);
+    // Parsed lazily on first access of Response::cookies
+    return Cookies{std::shared_ptr<curl_slist>(raw_cookies, curl_slist_free_all)};
+}
 
+Response Session::Complete(CURLcode curl_error) {
+    Cookies cookies = getResponseCookies();
+
+    const bool useSink = responseSink_ && !cbs_->writecb_.callback && !cbs_->ssecb_.callback;
     std::string errorMsg = curl_->error.data();
-    return Response(curl_, std::move(response_string_), std::move(header_string_), std::move(cookies), Error(curl_error, std::move(errorMsg)));
+    if (useSink && !responseSink_->Flush() && curl_error == CURLE_OK) {
+        curl_error = CURLE_WRITE_ERROR;
+        errorMsg = "Failed to flush the response sink";
+    }
+    Response response(curl_, std::move(response_string_), std::move(header_string_), std::move(cookies), Error(curl_error, std::move(errorMsg)), responseFields_);
+    if (useSink) {
+        // The sink belongs to this response from now on, the next request must not clear it
+        response.sink = std::move(responseSink_);
+    }
+    response.bufferPool_ = bufferPool_;
+    if (detachResponse_.detach) {
+        response.Detach(detachResponse_.cert_infos);
+    }
+    return response;
 }
 
 Response Session::CompleteDownload(CURLcode curl_error) {
@@ -966,13 +1381,21 @@ Response Session::CompleteDownload(CURLcode curl_error) {
         curl_easy_setopt(curl_->handle, CURLOPT_HEADERDATA, 0);
     }
 
-    curl_slist* raw_cookies{nullptr};
-    curl_easy_getinfo(curl_->handle, CURLINFO_COOKIELIST, &raw_cookies);
-    Cookies cookies = util::parseCookies(raw_cookies);
-    curl_slist_free_all(raw_cookies);
+    Cookies cookies = getResponseCookies();
     std::string errorMsg = curl_->error.data();
+    if (downloadSink_ && !downloadSink_->Flush() && curl_error == CURLE_OK) {
+        curl_error = CURLE_WRITE_ERROR;
+        errorMsg = "Failed to flush the download sink";
+    }
 
-    return Response(curl_, "", std::move(header_string_), std::move(cookies), Error(curl_error, std::move(errorMsg)));
+    Response response(curl_, "", std::move(header_string_), std::move(cookies), Error(curl_error, std::move(errorMsg)), responseFields_);
+    // The request is done, the session must not keep the sink of the caller alive
+    response.sink = std::move(downloadSink_);
+    response.bufferPool_ = bufferPool_;
+    if (detachResponse_.detach) {
+        response.Detach(detachResponse_.cert_infos);
+    }
+    return response;
 }
 
 void Session::AddInterceptor(const std::shared_ptr<Interceptor>& pinterceptor) {
@@ -1009,23 +1432,170 @@ const std::optional<Response> Session::intercept() {
     return std::nullopt;
 }
 
-void Session::prepareBodyPayloadOrMultipart() const {
+void Session::resetBodyStream() {
+    if (!bodyStreamPrepared_ && !compressionStream_) {
+        return;
+    }
+    // The file body may already be gone, so make sure curl does not access it any more
+    if (cbs_->readcb_.callback) {
+        curl_easy_setopt(curl_->handle, CURLOPT_INFILESIZE_LARGE, cbs_->readcb_.size);
+        curl_easy_setopt(curl_->handle, CURLOPT_POSTFIELDSIZE_LARGE, cbs_->readcb_.size);
+        curl_easy_setopt(curl_->handle, CURLOPT_READFUNCTION, cpr::util::readUserFunction);
+        curl_easy_setopt(curl_->handle, CURLOPT_READDATA, &cbs_->readcb_);
+    } else {
+        curl_easy_setopt(curl_->handle, CURLOPT_READFUNCTION, nullptr);
+        curl_easy_setopt(curl_->handle, CURLOPT_READDATA, nullptr);
+    }
+    curl_easy_setopt(curl_->handle, CURLOPT_SEEKFUNCTION, nullptr);
+    curl_easy_setopt(curl_->handle, CURLOPT_SEEKDATA, nullptr);
+#if LIBCURL_VERSION_NUM >= 0x073E00 // 7.62.0
+    curl_easy_setopt(curl_->handle, CURLOPT_UPLOAD_BUFFERSIZE, DEFAULT_UPLOAD_BUFFER_SIZE);
+#endif
+    bodyStreamPrepared_ = false;
+    compressionStream_.reset();
+}
+
+bool Session::prepareCompressedBody() {
+    if (std::holds_alternative<cpr::Payload>(content_) || std::holds_alternative<cpr::Body>(content_) || std::holds_alternative<cpr::BodyView>(content_)) {
+        // Only compress the body again in case it changed
+        if (!compressedContent_) {
+            std::string_view body;
+            if (std::holds_alternative<cpr::Payload>(content_)) {
+                if (!payloadContent_) {
+                    payloadContent_ = std::get<cpr::Payload>(content_).GetContent(*curl_);
+                }
+                body = *payloadContent_;
+            } else if (std::holds_alternative<cpr::Body>(content_)) {
+                body = std::get<cpr::Body>(content_).str();
+            } else {
+                body = std::get<cpr::BodyView>(content_).str();
+            }
+            compressedContent_ = util::Compressor::CompressAll(*requestCompression_, body);
+        }
+        curl_easy_setopt(curl_->handle, CURLOPT_POSTFIELDSIZE_LARGE, static_cast<curl_off_t>(compressedContent_->length()));
+        curl_easy_setopt(curl_->handle, CURLOPT_POSTFIELDS, compressedContent_->data());
+    } else if (std::holds_alternative<cpr::FileBody>(content_)) {
+        const cpr::FileBody& body = std::get<cpr::FileBody>(content_);
+        body.Seek(0);
+        compressionStream_ = std::make_unique<util::CompressionStream>(
+                *requestCompression_,
+                [&body](char* buffer, size_t& size) {
+                    size = body.Read(buffer, size);
+                    return size > 0 || !body.HasError();
+                },
+                [&body]() { return body.Seek(0); });
+        curl_easy_setopt(curl_->handle, CURLOPT_POSTFIELDS, nullptr);
+    } else if (std::holds_alternative<cpr::PayloadStream>(content_)) {
+        cpr::PayloadStream& payload = std::get<cpr::PayloadStream>(content_);
+        payload.Rewind();
+        compressionStream_ = std::make_unique<util::CompressionStream>(
+                *requestCompression_,
+                [&payload](char* buffer, size_t& size) {
+                    try {
+                        size = payload.Read(buffer, size);
+                        return true;
+                    } catch (const std::exception&) {
+                        return false;
+                    }
+                },
+                [&payload]() {
+                    payload.Rewind();
+                    return true;
+                });
+        curl_easy_setopt(curl_->handle, CURLOPT_POSTFIELDS, nullptr);
+    } else if (!hasBodyOrPayload() && !std::holds_alternative<cpr::Multipart>(content_) && cbs_->readcb_.callback) {
+        // The callback might change, so always call the current one
+        compressionStream_ = std::make_unique<util::CompressionStream>(*requestCompression_, [this](char* buffer, size_t& size) { return cbs_->readcb_(buffer, size); }, std::function<bool()>{});
+    } else {
+        return false;
+    }
+
+    if (compressionStream_) {
+        // The compressed size is only known once everything has been sent
+        curl_easy_setopt(curl_->handle, CURLOPT_INFILESIZE_LARGE, static_cast<curl_off_t>(-1));
+        curl_easy_setopt(curl_->handle, CURLOPT_POSTFIELDSIZE_LARGE, static_cast<curl_off_t>(-1));
+        curl_easy_setopt(curl_->handle, CURLOPT_READFUNCTION, cpr::util::readCompressedFunction);
+        curl_easy_setopt(curl_->handle, CURLOPT_READDATA, compressionStream_.get());
+        curl_easy_setopt(curl_->handle, CURLOPT_SEEKFUNCTION, cpr::util::seekCompressedFunction);
+        curl_easy_setopt(curl_->handle, CURLOPT_SEEKDATA, compressionStream_.get());
+        // prepareHeader(...) already added it for read callbacks of unknown size
+        if (!chunkedTransferEncoding_ && header_.find("Transfer-Encoding") == header_.end()) {
+            appendHeader("Transfer-Encoding:chunked");
+        }
+    }
+    // Like for the transfer encoding, a header set explicitly takes precedence
+    if (header_.find("Content-Encoding") == header_.end()) {
+        const std::string content_encoding = std::string{"Content-Encoding: "} + requestCompression_->GetContentEncoding();
+        appendHeader(content_encoding.c_str());
+    }
+    return true;
+}
+
+void Session::prepareBodyPayloadOrMultipart() {
     // Either a body, multipart or a payload is allowed. Inverse function to RemoveContent()
+    resetBodyStream();
+    if (requestCompression_ && prepareCompressedBody()) {
+        return;
+    }
 
+    // The session owns the data of bodies and payloads until the next prepare call, so curl does not have to copy it
     if (std::holds_alternative<cpr::Payload>(content_)) {
-        const std::string payload = std::get<cpr::Payload>(content_).GetContent(*curl_);
-        curl_easy_setopt(curl_->handle, CURLOPT_POSTFIELDSIZE_LARGE, static_cast<curl_off_t>(payload.length()));
-        curl_easy_setopt(curl_->handle, CURLOPT_COPYPOSTFIELDS, payload.c_str());
+        // Only encode the payload again in case it changed
+        if (!payloadContent_) {
+            payloadContent_ = std::get<cpr::Payload>(content_).GetContent(*curl_);
+        }
+        curl_easy_setopt(curl_->handle, CURLOPT_POSTFIELDSIZE_LARGE, static_cast<curl_off_t>(payloadContent_->length()));
+        curl_easy_setopt(curl_->handle, CURLOPT_POSTFIELDS, payloadContent_->c_str());
     } else if (std::holds_alternative<cpr::Body>(content_)) {
         const std::string& body = std::get<cpr::Body>(content_).str();
         curl_easy_setopt(curl_->handle, CURLOPT_POSTFIELDSIZE_LARGE, static_cast<curl_off_t>(body.length()));
-        curl_easy_setopt(curl_->handle, CURLOPT_COPYPOSTFIELDS, body.c_str());
+        curl_easy_setopt(curl_->handle, CURLOPT_POSTFIELDS, body.c_str());
     } else if (std::holds_alternative<cpr::BodyView>(content_)) {
         const std::string_view body = std::get<cpr::BodyView>(content_).str();
         curl_easy_setopt(curl_->handle, CURLOPT_POSTFIELDSIZE_LARGE, static_cast<curl_off_t>(body.length()));
         // NOLINTNEXTLINE (bugprone-suspicious-stringview-data-usage)
         curl_easy_setopt(curl_->handle, CURLOPT_POSTFIELDS, body.data());
+    } else if (std::holds_alternative<cpr::FileBody>(content_)) {
+        // Without post fields, curl pulls the body through the read callback
+        const cpr::FileBody& body = std::get<cpr::FileBody>(content_);
+        body.Seek(0);
+        curl_easy_setopt(curl_->handle, CURLOPT_POSTFIELDSIZE_LARGE, static_cast<curl_off_t>(body.GetSize()));
+        curl_easy_setopt(curl_->handle, CURLOPT_POSTFIELDS, nullptr);
+        curl_easy_setopt(curl_->handle, CURLOPT_READFUNCTION, cpr::util::readFileBodyFunction);
+        curl_easy_setopt(curl_->handle, CURLOPT_READDATA, &body);
+        curl_easy_setopt(curl_->handle, CURLOPT_SEEKFUNCTION, cpr::util::seekFileBodyFunction);
+        curl_easy_setopt(curl_->handle, CURLOPT_SEEKDATA, &body);
+#if LIBCURL_VERSION_NUM >= 0x073E00 // 7.62.0
+        curl_easy_setopt(curl_->handle, CURLOPT_UPLOAD_BUFFERSIZE, static_cast<long>(cpr::FileBody::READ_SIZE));
+#endif
+        bodyStreamPrepared_ = true;
+    } else if (std::holds_alternative<cpr::PayloadStream>(content_)) {
+        cpr::PayloadStream& payload = std::get<cpr::PayloadStream>(content_);
+        // Computing the size rewinds the payload as well
+        if (payload.chunked) {
+            payload.Rewind();
+        }
+        curl_easy_setopt(curl_->handle, CURLOPT_POSTFIELDSIZE_LARGE, payload.chunked ? static_cast<curl_off_t>(-1) : static_cast<curl_off_t>(payload.GetSize()));
+        curl_easy_setopt(curl_->handle, CURLOPT_POSTFIELDS, nullptr);
+        curl_easy_setopt(curl_->handle, CURLOPT_READFUNCTION, cpr::util::readPayloadStreamFunction);
+        curl_easy_setopt(curl_->handle, CURLOPT_READDATA, &payload);
+        curl_easy_setopt(curl_->handle, CURLOPT_SEEKFUNCTION, cpr::util::seekPayloadStreamFunction);
+        curl_easy_setopt(curl_->handle, CURLOPT_SEEKDATA, &payload);
+#if LIBCURL_VERSION_NUM >= 0x073E00 // 7.62.0
+        curl_easy_setopt(curl_->handle, CURLOPT_UPLOAD_BUFFERSIZE, static_cast<long>(cpr::PayloadStream::READ_SIZE));
+#endif
+        // prepareHeader(...) already added it for read callbacks of unknown size
+        if (payload.chunked && !chunkedTransferEncoding_ && header_.find("Transfer-Encoding") == header_.end()) {
+            appendHeader("Transfer-Encoding:chunked");
+        }
+        bodyStreamPrepared_ = true;
     } else if (std::holds_alternative<cpr::Multipart>(content_)) {
+        // The parts did not change since the last request, so curl can send the same mime structure again
+        if (curl_->multipart && multipartPrepared_) {
+            curl_easy_setopt(curl_->handle, CURLOPT_MIMEPOST, curl_->multipart);
+            return;
+        }
+
         // Make sure, we have a empty multipart to start with:
         if (curl_->multipart) {
             curl_mime_free(curl_->multipart);
@@ -1034,6 +1604,9 @@ void Session::prepareBodyPayloadOrMultipart() const {
 
         // Add all multipart pieces:
         const cpr::Multipart& multipart = std::get<cpr::Multipart>(content_);
+        // Readers get referenced by curl, so they must not be reallocated while adding parts
+        multipartReaders_.clear();
+        multipartReaders_.reserve(multipart.parts.size());
         for (const Part& part : multipart.parts) {
             if (part.is_file) {
                 for (const File& file : part.files) {
@@ -1057,24 +1630,23 @@ void Session::prepareBodyPayloadOrMultipart() const {
                 if (!part.content_type.empty()) {
                     curl_mime_type(mimePart, part.content_type.c_str());
                 }
+                curl_mime_name(mimePart, part.name.c_str());
+                // Stream the data from where it is instead of letting curl copy it
+                util::MimeDataReader& reader = part.is_buffer ? multipartReaders_.emplace_back(util::MimeDataReader{part.data, part.datalen, 0}) : multipartReaders_.emplace_back(util::MimeDataReader{part.value.data(), part.value.size(), 0});
+                curl_mime_data_cb(mimePart, static_cast<curl_off_t>(reader.size), cpr::util::readMimeDataFunction, cpr::util::seekMimeDataFunction, nullptr, &reader);
                 if (part.is_buffer) {
-                    // Do not use formdata, to prevent having to use reinterpreter_cast:
-                    curl_mime_name(mimePart, part.name.c_str());
-                    curl_mime_data(mimePart, part.data, part.datalen);
                     curl_mime_filename(mimePart, part.value.c_str());
-                } else {
-                    curl_mime_name(mimePart, part.name.c_str());
-                    curl_mime_data(mimePart, part.value.c_str(), CURL_ZERO_TERMINATED);
                 }
             }
         }
 
         curl_easy_setopt(curl_->handle, CURLOPT_MIMEPOST, curl_->multipart);
+        multipartPrepared_ = true;
     }
 }
 
 [[nodiscard]] bool Session::hasBodyOrPayload() const {
-    return std::holds_alternative<cpr::Body>(content_) || std::holds_alternative<cpr::BodyView>(content_) || std::holds_alternative<cpr::Payload>(content_);
+    return std::holds_alternative<cpr::Body>(content_) || std::holds_alternative<cpr::BodyView>(content_) || std::holds_alternative<cpr::Payload>(content_) || std::holds_alternative<cpr::FileBody>(content_) || std::holds_alternative<cpr::PayloadStream>(content_);
 }
 
 // clang-format off
@@ -1086,6 +1658,7 @@ void Session::SetOption(const WriteCallback& write) { SetWriteCallback(write); }
 void Session::SetOption(const ProgressCallback& progress) { SetProgressCallback(progress); }
 void Session::SetOption(const DebugCallback& debug) { SetDebugCallback(debug); }
 void Session::SetOption(const ServerSentEventCallback& sse) { SetServerSentEventCallback(sse); }
+void Session::SetOption(const ServerSentEventReconnect& reconnect) { SetServerSentEventReconnect(reconnect); }
 void Session::SetOption(const Url& url) { SetUrl(url); }
 void Session::SetOption(const Parameters& parameters) { SetParameters(parameters); }
 void Session::SetOption(Parameters&& parameters) { SetParameters(std::move(parameters)); }
@@ -1110,10 +1683,16 @@ void Session::SetOption(const Multipart& multipart) { SetMultipart(multipart); }
 void Session::SetOption(Multipart&& multipart) { SetMultipart(std::move(multipart)); }
 void Session::SetOption(const Redirect& redirect) { SetRedirect(redirect); }
 void Session::SetOption(const Cookies& cookies) { SetCookies(cookies); }
+void Session::SetOption(const CookieEngine& cookie_engine) { SetCookieEngine(cookie_engine); }
+void Session::SetOption(const CookieJar& jar) { SetCookieJar(jar); }
+void Session::SetOption(const ResponseFields& fields) { SetResponseFields(fields); }
+void Session::SetOption(const DetachResponse& detach) { SetDetachResponse(detach); }
 void Session::SetOption(const Body& body) { SetBody(body); }
 void Session::SetOption(Body&& body) { SetBody(std::move(body)); }
 // cppcheck-suppress passedByValue
 void Session::SetOption(BodyView body) { SetBodyView(body); }
+void Session::SetOption(const FileBody& body) { SetFileBody(body); }
+void Session::SetOption(const PayloadStream& payload) { SetPayloadStream(payload); }
 void Session::SetOption(const LowSpeed& low_speed) { SetLowSpeed(low_speed); }
 void Session::SetOption(const VerifySsl& verify) { SetVerifySsl(verify); }
 void Session::SetOption(const Verbose& verbose) { SetVerbose(verbose); }
@@ -1126,9 +1705,14 @@ void Session::SetOption(const HttpVersion& version) { SetHttpVersion(version); }
 void Session::SetOption(const Range& range) { SetRange(range); }
 void Session::SetOption(const MultiRange& multi_range) { SetMultiRange(multi_range); }
 void Session::SetOption(const ReserveSize& reserve_size) { SetReserveSize(reserve_size); }
+void Session::SetOption(const AutoReserveSize& auto_reserve_size) { SetAutoReserveSize(auto_reserve_size); }
 void Session::SetOption(const AcceptEncoding& accept_encoding) { SetAcceptEncoding(accept_encoding); }
 void Session::SetOption(AcceptEncoding&& accept_encoding) { SetAcceptEncoding(std::move(accept_encoding)); }
+void Session::SetOption(const RequestCompression& compression) { SetRequestCompression(compression); }
 void Session::SetOption(const ConnectionPool& pool) { SetConnectionPool(pool); }
+void Session::SetOption(const BufferPool& pool) { SetBufferPool(pool); }
+void Session::SetOption(const RequestArena& arena) { SetRequestArena(arena); }
+void Session::SetOption(const std::shared_ptr<ResponseSink>& sink) { SetResponseSink(sink); }
 // clang-format on
 
 void Session::SetCancellationParam(std::shared_ptr<std::atomic_bool> param) {
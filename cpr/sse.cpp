@@ -2,7 +2,9 @@
 
 #include <charconv>
 #include <cstddef>
+#include <cstring>
 #include <functional>
+#include <optional>
 #include <string>
 #include <string_view>
 #include <system_error>
@@ -11,34 +13,73 @@
 namespace cpr {
 
 bool ServerSentEventParser::parse(std::string_view data, const std::function<bool(ServerSentEvent&&)>& callback) {
-    // Append incoming data to buffer
-    buffer_.append(data);
+    if (aborted_) {
+        // The rest of a chunk a callback aborted on, parse it together with the new data
+        aborted_ = false;
+        std::string rest = std::move(buffer_);
+        buffer_ = std::string{};
+        rest.append(data);
+        return parse(rest, callback);
+    }
 
-    // Process complete lines
     size_t pos = 0;
-    while ((pos = buffer_.find('\n')) != std::string::npos) {
-        std::string line = buffer_.substr(0, pos);
-        buffer_.erase(0, pos + 1);
+    while (pos < data.size()) {
+        // memchr is vectorized by the C library, so the content of each line gets skipped at once
+        const void* newline = std::memchr(data.data() + pos, '\n', data.size() - pos); // NOLINT (cppcoreguidelines-pro-bounds-pointer-arithmetic)
+        if (!newline) {
+            break;
+        }
+        const size_t end = static_cast<size_t>(static_cast<const char*>(newline) - data.data());
+        std::string_view line = data.substr(pos, end - pos);
+        pos = end + 1;
+
+        // Complete the line started by the previous chunk
+        if (!buffer_.empty()) {
+            buffer_.append(line);
+            line = buffer_;
+        }
 
         // Remove trailing \r if present (handles both \n and \r\n)
         if (!line.empty() && line.back() == '\r') {
-            line.pop_back();
+            line.remove_suffix(1);
         }
 
-        if (!processLine(line, callback)) {
+        const bool continue_parsing = processLine(line, callback);
+        buffer_.clear();
+        if (!continue_parsing) {
+            // Keep the rest, so parsing can be continued later on
+            buffer_.assign(data.substr(pos));
+            aborted_ = true;
             return false;
         }
     }
 
+    // Only the incomplete last line gets carried over to the next chunk
+    buffer_.append(data.substr(pos));
     return true;
 }
 
 void ServerSentEventParser::reset() {
+    discardEvent();
+    last_event_id_.reset();
+    retry_.reset();
+}
+
+void ServerSentEventParser::discardEvent() {
     buffer_.clear();
+    aborted_ = false;
     current_event_ = ServerSentEvent();
 }
 
-bool ServerSentEventParser::processLine(const std::string& line, const std::function<bool(ServerSentEvent&&)>& callback) {
+const std::optional<std::string>& ServerSentEventParser::lastEventId() const {
+    return last_event_id_;
+}
+
+std::optional<size_t> ServerSentEventParser::retry() const {
+    return retry_;
+}
+
+bool ServerSentEventParser::processLine(std::string_view line, const std::function<bool(ServerSentEvent&&)>& callback) {
     // Empty line means end of event
     if (line.empty()) {
         return dispatchEvent(callback);
@@ -49,24 +90,16 @@ bool ServerSentEventParser::processLine(const std::string& line, const std::func
         return true;
     }
 
-    // Find the colon separator
+    // Find the colon separator, without one the entire line is the field name and the value is empty
     const size_t colon_pos = line.find(':');
-
-    std::string field;
-    std::string value;
-
-    if (colon_pos == std::string::npos) {
-        // No colon, entire line is the field name
-        field = line;
-        value = "";
-    } else {
-        field = line.substr(0, colon_pos);
+    const std::string_view field = line.substr(0, colon_pos);
+    std::string_view value;
+    if (colon_pos != std::string_view::npos) {
         // Skip the colon and optional leading space
-        size_t value_start = colon_pos + 1;
-        if (value_start < line.size() && line[value_start] == ' ') {
-            value_start++;
+        value = line.substr(colon_pos + 1);
+        if (!value.empty() && value[0] == ' ') {
+            value.remove_prefix(1);
         }
-        value = line.substr(value_start);
     }
 
     // Process the field
@@ -80,18 +113,18 @@ bool ServerSentEventParser::processLine(const std::string& line, const std::func
         current_event_.data += value;
     } else if (field == "id") {
         // Only set id if the value doesn't contain null character
-        if (value.find('\0') == std::string::npos) {
+        if (value.find('\0') == std::string_view::npos) {
             current_event_.id = value;
         }
     } else if (field == "retry") {
         // Parse retry value as integer
         size_t retry_value = 0;
-        const std::string_view sv(value);
-        const char* begin = sv.data();
-        const char* end = begin + sv.size(); // NOLINT (cppcoreguidelines-pro-bounds-pointer-arithmetic) Required here since Windows and Clang/GCC have different std::string_view iterator implementations
+        const char* begin = value.data();
+        const char* end = begin + value.size(); // NOLINT (cppcoreguidelines-pro-bounds-pointer-arithmetic) Required here since Windows and Clang/GCC have different std::string_view iterator implementations
         auto [ptr, ec] = std::from_chars(begin, end, retry_value);
         if (ec == std::errc()) {
             current_event_.retry = retry_value;
+            retry_ = retry_value;
         }
     }
     // Unknown fields are ignored per spec
@@ -100,6 +133,11 @@ bool ServerSentEventParser::processLine(const std::string& line, const std::func
 }
 
 bool ServerSentEventParser::dispatchEvent(const std::function<bool(ServerSentEvent&&)>& callback) {
+    // The ID applies once the event is complete, even in case it has no data
+    if (current_event_.id.has_value()) {
+        last_event_id_ = *current_event_.id;
+    }
+
     // Don't dispatch if data is empty
     if (current_event_.data.empty()) {
         current_event_ = ServerSentEvent();
@@ -119,4 +157,16 @@ bool ServerSentEventCallback::handleData(std::string_view data) {
     return parser_.parse(data, [this](ServerSentEvent&& event) { return (*this)(std::move(event)); });
 }
 
+void ServerSentEventCallback::discardEvent() {
+    parser_.discardEvent();
+}
+
+const std::optional<std::string>& ServerSentEventCallback::lastEventId() const {
+    return parser_.lastEventId();
+}
+
+std::optional<size_t> ServerSentEventCallback::retry() const {
+    return parser_.retry();
+}
+
 } // namespace cpr
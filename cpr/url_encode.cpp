@@ -0,0 +1,179 @@
+#include "cpr/url_encode.h"
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <string_view>
+
+#include "cpr/secure_string.h"
+
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+
+namespace cpr::util {
+namespace {
+// NOLINTNEXTLINE (cppcoreguidelines-avoid-c-arrays, hicpp-avoid-c-arrays, modernize-avoid-c-arrays)
+constexpr char HEX_DIGITS[] = "0123456789ABCDEF";
+
+constexpr std::array<bool, 256> UNRESERVED = [] {
+    std::array<bool, 256> table{};
+    for (size_t c = 0; c < table.size(); c++) {
+        table[c] = (c >= 'A' && c <= 'Z') || (c >= 'a' && c <= 'z') || (c >= '0' && c <= '9') || c == '-' || c == '.' || c == '_' || c == '~';
+    }
+    return table;
+}();
+
+// The value of each hex digit, -1 for any other character
+constexpr std::array<int8_t, 256> HEX_VALUES = [] {
+    std::array<int8_t, 256> table{};
+    for (size_t c = 0; c < table.size(); c++) {
+        if (c >= '0' && c <= '9') {
+            table[c] = static_cast<int8_t>(c - '0');
+        } else if (c >= 'A' && c <= 'F') {
+            table[c] = static_cast<int8_t>(c - 'A' + 10);
+        } else if (c >= 'a' && c <= 'f') {
+            table[c] = static_cast<int8_t>(c - 'a' + 10);
+        } else {
+            table[c] = -1;
+        }
+    }
+    return table;
+}();
+
+bool isUnreserved(char c) {
+    return UNRESERVED[static_cast<unsigned char>(c)];
+}
+
+/**
+ * Returns the number of characters at the start of data that do not need to be encoded.
+ * Text usually consists of long runs of those, so they get checked 16 bytes at once where SSE2 is available.
+ **/
+size_t unreservedPrefix(const char* data, size_t size) {
+    size_t pos = 0;
+#ifdef __SSE2__
+    const auto inRange = [](__m128i chars, char first, char last) { return _mm_and_si128(_mm_cmpgt_epi8(chars, _mm_set1_epi8(static_cast<char>(first - 1))), _mm_cmplt_epi8(chars, _mm_set1_epi8(static_cast<char>(last + 1)))); };
+    for (; pos + 16 <= size; pos += 16) {
+        // NOLINTNEXTLINE (cppcoreguidelines-pro-type-reinterpret-cast, cppcoreguidelines-pro-bounds-pointer-arithmetic)
+        const __m128i chars = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + pos));
+        // Bytes >= 0x80 are negative as signed chars, so they never fall into any of the ranges
+        __m128i unreserved = _mm_or_si128(_mm_or_si128(inRange(chars, 'A', 'Z'), inRange(chars, 'a', 'z')), inRange(chars, '0', '9'));
+        unreserved = _mm_or_si128(unreserved, _mm_or_si128(_mm_cmpeq_epi8(chars, _mm_set1_epi8('-')), _mm_cmpeq_epi8(chars, _mm_set1_epi8('.'))));
+        unreserved = _mm_or_si128(unreserved, _mm_or_si128(_mm_cmpeq_epi8(chars, _mm_set1_epi8('_')), _mm_cmpeq_epi8(chars, _mm_set1_epi8('~'))));
+        const unsigned int mask = static_cast<unsigned int>(_mm_movemask_epi8(unreserved));
+        if (mask != 0xFFFF) {
+            return pos + static_cast<size_t>(__builtin_ctz(~mask));
+        }
+    }
+#endif
+    // NOLINTNEXTLINE (cppcoreguidelines-pro-bounds-pointer-arithmetic)
+    while (pos < size && isUnreserved(data[pos])) {
+        pos++;
+    }
+    return pos;
+}
+
+template <typename String>
+String decodeToString(std::string_view s) {
+    String result(s.size(), '\0');
+    result.resize(urlDecode(s, result.data()));
+    return result;
+}
+
+template <typename String>
+String encodeToString(std::string_view s) {
+    String result(urlEncodedSize(s), '\0');
+    urlEncode(s, result.data());
+    return result;
+}
+} // namespace
+
+size_t urlEncodedSize(std::string_view s) {
+    size_t size = s.size();
+    size_t pos = 0;
+    while (true) {
+        pos += unreservedPrefix(s.data() + pos, s.size() - pos); // NOLINT (cppcoreguidelines-pro-bounds-pointer-arithmetic)
+        if (pos == s.size()) {
+            return size;
+        }
+        // '%XX' instead of the character
+        size += 2;
+        pos++;
+    }
+}
+
+size_t urlEncode(std::string_view s, char* output) {
+    char* out = output;
+    size_t pos = 0;
+    // NOLINTBEGIN (cppcoreguidelines-pro-bounds-pointer-arithmetic)
+    while (true) {
+        const size_t run = unreservedPrefix(s.data() + pos, s.size() - pos);
+        std::memcpy(out, s.data() + pos, run);
+        out += run;
+        pos += run;
+        if (pos == s.size()) {
+            break;
+        }
+        const auto c = static_cast<unsigned char>(s[pos++]);
+        *out++ = '%';
+        *out++ = HEX_DIGITS[c >> 4U];
+        *out++ = HEX_DIGITS[c & 0x0FU];
+    }
+    // NOLINTEND (cppcoreguidelines-pro-bounds-pointer-arithmetic)
+    return static_cast<size_t>(out - output);
+}
+
+size_t urlDecode(std::string_view s, char* output) {
+    char* out = output;
+    size_t pos = 0;
+    // NOLINTBEGIN (cppcoreguidelines-pro-bounds-pointer-arithmetic)
+    while (pos < s.size()) {
+        // memchr is vectorized by the C library, so the runs between escapes get copied at once
+        const void* percent = std::memchr(s.data() + pos, '%', s.size() - pos);
+        const size_t next = percent ? static_cast<size_t>(static_cast<const char*>(percent) - s.data()) : s.size();
+        std::memcpy(out, s.data() + pos, next - pos);
+        out += next - pos;
+        pos = next;
+        if (pos == s.size()) {
+            break;
+        }
+        const int high = pos + 2 < s.size() ? HEX_VALUES[static_cast<unsigned char>(s[pos + 1])] : -1;
+        const int low = high >= 0 ? HEX_VALUES[static_cast<unsigned char>(s[pos + 2])] : -1;
+        if (low >= 0) {
+            *out++ = static_cast<char>((high << 4) | low);
+            pos += 3;
+        } else {
+            // Not a valid escape, keep it as it is
+            *out++ = '%';
+            pos++;
+        }
+    }
+    // NOLINTEND (cppcoreguidelines-pro-bounds-pointer-arithmetic)
+    return static_cast<size_t>(out - output);
+}
+
+void appendUrlEncoded(std::string& output, std::string_view s) {
+    const size_t offset = output.size();
+    output.resize(offset + urlEncodedSize(s));
+    urlEncode(s, output.data() + offset); // NOLINT (cppcoreguidelines-pro-bounds-pointer-arithmetic)
+}
+
+std::string urlEncode(std::string_view s) {
+    return encodeToString<std::string>(s);
+}
+
+std::string urlDecode(std::string_view s) {
+    return decodeToString<std::string>(s);
+}
+
+util::SecureString urlEncodeSecure(std::string_view s) {
+    return encodeToString<util::SecureString>(s);
+}
+
+util::SecureString urlDecodeSecure(std::string_view s) {
+    return decodeToString<util::SecureString>(s);
+}
+
+} // namespace cpr::util
@@ -1,21 +1,32 @@
 #include "cpr/util.h"
 #include "cpr/callback.h"
+#include "cpr/content_decoder.h"
 #include "cpr/cookies.h"
 #include "cpr/cprtypes.h"
+#include "cpr/file_body.h"
+#include "cpr/payload_stream.h"
+#include "cpr/request_compression.h"
+#include "cpr/response_sink.h"
 #include "cpr/curlholder.h"
 #include "cpr/secure_string.h"
 #include "cpr/sse.h"
 #include <algorithm>
 #include <cctype>
+#include <cstdio>
+#include <charconv>
 #include <chrono>
 #include <cstdint>
 #include <ctime>
+#include <exception>
 #include <curl/curl.h>
 #include <fstream>
 #include <ios>
+#include <optional>
 #include <sstream>
 #include <string>
+#include <string_view>
 #include <type_traits>
+#include <utility>
 #include <vector>
 
 #ifdef _Win32
@@ -114,6 +125,70 @@ Header parseHeader(const std::string& headers, std::string* status_line, std::st
     return header;
 }
 
+namespace {
+// Returns the value of the given header line without surrounding whitespace in case it is the field with the given lowercase name
+std::optional<std::string_view> headerFieldValue(std::string_view header_line, std::string_view name) {
+    if (header_line.size() <= name.size() || header_line[name.size()] != ':') {
+        return std::nullopt;
+    }
+    for (size_t i = 0; i < name.size(); i++) {
+        if (std::tolower(static_cast<unsigned char>(header_line[i])) != name[i]) {
+            return std::nullopt;
+        }
+    }
+    header_line.remove_prefix(name.size() + 1);
+    while (!header_line.empty() && (header_line.front() == ' ' || header_line.front() == '\t')) {
+        header_line.remove_prefix(1);
+    }
+    while (!header_line.empty() && (header_line.back() == ' ' || header_line.back() == '\t' || header_line.back() == '\r' || header_line.back() == '\n')) {
+        header_line.remove_suffix(1);
+    }
+    return header_line;
+}
+
+// Parses the whole value as a non-negative number
+template <typename T>
+std::optional<T> parseNumber(std::string_view value) {
+    T number{0};
+    const char* end = value.data() + value.size(); // NOLINT (cppcoreguidelines-pro-bounds-pointer-arithmetic)
+    const std::from_chars_result result = std::from_chars(value.data(), end, number);
+    if (result.ec != std::errc() || result.ptr == value.data() || result.ptr != end) {
+        return std::nullopt;
+    }
+    if constexpr (std::is_signed_v<T>) {
+        if (number < 0) {
+            return std::nullopt;
+        }
+    }
+    return number;
+}
+} // namespace
+
+std::optional<size_t> parseContentLength(std::string_view header_line) {
+    const std::optional<std::string_view> value = headerFieldValue(header_line, "content-length");
+    return value ? parseNumber<size_t>(*value) : std::nullopt;
+}
+
+std::optional<std::pair<cpr_off_t, cpr_off_t>> parseContentRange(std::string_view header_line) {
+    std::optional<std::string_view> value = headerFieldValue(header_line, "content-range");
+    constexpr std::string_view unit{"bytes "};
+    if (!value || value->substr(0, unit.size()) != unit) {
+        return std::nullopt;
+    }
+    value->remove_prefix(unit.size());
+    const size_t dash = value->find('-');
+    const size_t slash = value->find('/');
+    if (dash == std::string_view::npos || slash == std::string_view::npos || slash < dash) {
+        return std::nullopt;
+    }
+    const std::optional<cpr_off_t> first = parseNumber<cpr_off_t>(value->substr(0, dash));
+    const std::optional<cpr_off_t> last = parseNumber<cpr_off_t>(value->substr(dash + 1, slash - dash - 1));
+    if (!first || !last || *last < *first) {
+        return std::nullopt;
+    }
+    return std::make_pair(*first, *last);
+}
+
 std::vector<std::string> split(const std::string& to_split, char delimiter) {
     std::vector<std::string> tokens;
 
@@ -131,6 +206,67 @@ size_t readUserFunction(char* ptr, size_t size, size_t nitems, const ReadCallbac
     return (*read)(ptr, size) ? size : CURL_READFUNC_ABORT;
 }
 
+size_t readFileBodyFunction(char* ptr, size_t size, size_t nitems, const FileBody* body) {
+    size *= nitems;
+    const size_t read = body->Read(ptr, size);
+    return (read == 0 && body->HasError()) ? CURL_READFUNC_ABORT : read;
+}
+
+int seekFileBodyFunction(const FileBody* body, cpr_off_t offset, int origin) {
+    // libcurl only rewinds relative to the beginning, e.g. when resending the body after a redirect
+    if (origin != SEEK_SET) {
+        return CURL_SEEKFUNC_CANTSEEK;
+    }
+    return body->Seek(offset) ? CURL_SEEKFUNC_OK : CURL_SEEKFUNC_FAIL;
+}
+
+size_t readPayloadStreamFunction(char* ptr, size_t size, size_t nitems, PayloadStream* payload) {
+    try {
+        return payload->Read(ptr, size * nitems);
+    } catch (const std::exception&) {
+        // Exceptions thrown while iterating over the pairs must not pass through curl
+        return CURL_READFUNC_ABORT;
+    }
+}
+
+int seekPayloadStreamFunction(PayloadStream* payload, cpr_off_t offset, int origin) {
+    // Encoding can only be restarted from the first pair
+    if (offset != 0 || origin != SEEK_SET) {
+        return CURL_SEEKFUNC_CANTSEEK;
+    }
+    payload->Rewind();
+    return CURL_SEEKFUNC_OK;
+}
+
+size_t readCompressedFunction(char* ptr, size_t size, size_t nitems, CompressionStream* stream) {
+    return stream->Read(ptr, size * nitems);
+}
+
+int seekCompressedFunction(CompressionStream* stream, cpr_off_t offset, int origin) {
+    // The compressed stream can only be restarted from the beginning
+    if (offset != 0 || origin != SEEK_SET) {
+        return CURL_SEEKFUNC_CANTSEEK;
+    }
+    return stream->Rewind() ? CURL_SEEKFUNC_OK : CURL_SEEKFUNC_FAIL;
+}
+
+size_t readMimeDataFunction(char* ptr, size_t size, size_t nitems, void* data) {
+    MimeDataReader* reader = static_cast<MimeDataReader*>(data);
+    size = std::min(size * nitems, reader->size - reader->offset);
+    std::copy_n(reader->data + reader->offset, size, ptr); // NOLINT (cppcoreguidelines-pro-bounds-pointer-arithmetic)
+    reader->offset += size;
+    return size;
+}
+
+int seekMimeDataFunction(void* data, cpr_off_t offset, int origin) {
+    MimeDataReader* reader = static_cast<MimeDataReader*>(data);
+    if (origin != SEEK_SET || offset < 0 || static_cast<size_t>(offset) > reader->size) {
+        return CURL_SEEKFUNC_FAIL;
+    }
+    reader->offset = static_cast<size_t>(offset);
+    return CURL_SEEKFUNC_OK;
+}
+
 size_t headerUserFunction(char* ptr, size_t size, size_t nmemb, const HeaderCallback* header) {
     size *= nmemb;
     return (*header)({ptr, size}) ? size : 0;
@@ -142,6 +278,27 @@ size_t writeFunction(char* ptr, size_t size, size_t nmemb, void* data) {
     return size;
 }
 
+size_t writeHeaderReserveFunction(char* ptr, size_t size, size_t nmemb, ContentLengthReserve* data) {
+    size *= nmemb;
+    data->header->append(ptr, size);
+
+    const std::optional<size_t> content_length = parseContentLength({ptr, size});
+    if (content_length) {
+        const size_t reserve_size = std::min(*content_length, data->max_size);
+        if (data->sink) {
+            data->sink->Reserve(reserve_size);
+        } else {
+            data->body->reserve(data->body->size() + reserve_size);
+        }
+    }
+    return size;
+}
+
+size_t writeSinkFunction(char* ptr, size_t size, size_t nmemb, ResponseSink* sink) {
+    size *= nmemb;
+    return sink->Write({ptr, size});
+}
+
 size_t writeFileFunction(char* ptr, size_t size, size_t nmemb, std::ofstream* file) {
     size *= nmemb;
     file->write(ptr, static_cast<std::streamsize>(size));
@@ -158,41 +315,16 @@ size_t writeSSEFunction(char* ptr, size_t size, size_t nmemb, ServerSentEventCal
     return sse->handleData({ptr, size}) ? size : 0;
 }
 
+size_t writeDecoderFunction(char* ptr, size_t size, size_t nmemb, ContentDecoder* decoder) {
+    size *= nmemb;
+    return decoder->Write({ptr, size});
+}
+
 int debugUserFunction(CURL* /*handle*/, curl_infotype type, char* data, size_t size, const DebugCallback* debug) {
     (*debug)(static_cast<DebugCallback::InfoType>(type), std::string(data, size));
     return 0;
 }
 
-/**
- * Creates a temporary CurlHolder object and uses it to escape the given string.
- * If you plan to use this methode on a regular basis think about creating a CurlHolder
- * object and calling urlEncode(std::string) on it.
- *
- * Example:
- * CurlHolder holder;
- * std::string input = "Hello World!";
- * std::string result = holder.urlEncode(input);
- **/
-util::SecureString urlEncode(std::string_view s) {
-    const CurlHolder holder; // Create a temporary new holder for URL encoding
-    return holder.urlEncode(s);
-}
-
-/**
- * Creates a temporary CurlHolder object and uses it to unescape the given string.
- * If you plan to use this methode on a regular basis think about creating a CurlHolder
- * object and calling urlDecode(std::string) on it.
- *
- * Example:
- * CurlHolder holder;
- * std::string input = "Hello%20World%21";
- * std::string result = holder.urlDecode(input);
- **/
-util::SecureString urlDecode(std::string_view s) {
-    const CurlHolder holder; // Create a temporary new holder for URL decoding
-    return holder.urlDecode(s);
-}
-
 bool isTrue(const std::string& s) {
     constexpr std::string_view tmp = "true";
     auto [s_it, tmp_it] = std::mismatch(s.begin(), s.end(), tmp.begin(), tmp.end(), [](auto s_c, auto t_c) { return std::tolower(s_c) == t_c; });
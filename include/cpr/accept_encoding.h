@@ -17,10 +17,12 @@ enum class AcceptEncodingMethods : uint8_t {
     zlib,
     gzip,
     disabled,
+    br,
+    zstd,
 };
 
 // NOLINTNEXTLINE(cert-err58-cpp)
-static const std::map<AcceptEncodingMethods, std::string> AcceptEncodingMethodsStringMap{{AcceptEncodingMethods::identity, "identity"}, {AcceptEncodingMethods::deflate, "deflate"}, {AcceptEncodingMethods::zlib, "zlib"}, {AcceptEncodingMethods::gzip, "gzip"}, {AcceptEncodingMethods::disabled, "disabled"}};
+static const std::map<AcceptEncodingMethods, std::string> AcceptEncodingMethodsStringMap{{AcceptEncodingMethods::identity, "identity"}, {AcceptEncodingMethods::deflate, "deflate"}, {AcceptEncodingMethods::zlib, "zlib"}, {AcceptEncodingMethods::gzip, "gzip"}, {AcceptEncodingMethods::br, "br"}, {AcceptEncodingMethods::zstd, "zstd"}, {AcceptEncodingMethods::disabled, "disabled"}};
 
 class AcceptEncoding {
   public:
@@ -31,6 +33,11 @@ class AcceptEncoding {
     [[nodiscard]] bool empty() const noexcept;
     [[nodiscard]] const std::string getString() const;
     [[nodiscard]] bool disabled() const;
+    /**
+     * Returns true in case libcurl has not been built with support for one of the methods, but cpr has (see util::ContentDecoder).
+     * Responses then get decoded by cpr instead of libcurl.
+     **/
+    [[nodiscard]] bool requiresContentDecoder() const;
 
   private:
     std::unordered_set<std::string> methods_;
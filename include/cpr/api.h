@@ -1,6 +1,7 @@
 #ifndef CPR_API_H
 #define CPR_API_H
 
+#include <chrono>
 #include <fstream>
 #include <functional>
 #include <future>
@@ -68,14 +69,14 @@ void apply_set_option(Session& session, Tuple&& t) {
 template <typename T>
 void setup_multiperform_internal(MultiPerform& multiperform, T&& t) {
     std::shared_ptr<Session> session = std::make_shared<Session>();
-    apply_set_option(*session, t);
+    apply_set_option(*session, std::forward<T>(t));
     multiperform.AddSession(session);
 }
 
 template <typename T, typename... Ts>
 void setup_multiperform_internal(MultiPerform& multiperform, T&& t, Ts&&... ts) {
     std::shared_ptr<Session> session = std::make_shared<Session>();
-    apply_set_option(*session, t);
+    apply_set_option(*session, std::forward<T>(t));
     multiperform.AddSession(session);
     setup_multiperform_internal<Ts...>(multiperform, std::forward<Ts>(ts)...);
 }
@@ -91,15 +92,18 @@ template <session_action_t SessionAction, typename T>
 void setup_multiasync(std::vector<AsyncWrapper<Response, true>>& responses, T&& parameters) {
     std::shared_ptr<std::atomic_bool> cancellation_state = std::make_shared<std::atomic_bool>(false);
 
-    std::function<Response(T)> execFn{[cancellation_state](T params) {
+    auto execFn = [cancellation_state, submitted = std::chrono::steady_clock::now()](auto&& params) {
         if (cancellation_state->load()) {
             return Response{};
         }
+        const std::chrono::microseconds queue = elapsed_since(submitted);
         cpr::Session s{};
         s.SetCancellationParam(cancellation_state);
-        apply_set_option(s, std::forward<T>(params));
-        return std::invoke(SessionAction, s);
-    }};
+        apply_set_option(s, std::forward<decltype(params)>(params));
+        Response response = std::invoke(SessionAction, s);
+        response.timings.queue += queue;
+        return response;
+    };
     responses.emplace_back(GlobalThreadPool::GetInstance()->Submit(std::move(execFn), std::forward<T>(parameters)), std::move(cancellation_state));
 }
 
@@ -123,15 +127,15 @@ Response Get(Ts&&... ts) {
 
 // Get async methods
 template <typename... Ts>
-AsyncResponse GetAsync(Ts... ts) {
-    return cpr::async([](Ts... ts_inner) { return Get(std::move(ts_inner)...); }, std::move(ts)...);
+AsyncResponse GetAsync(Ts&&... ts) {
+    return cpr::async([](auto&&... ts_inner) { return Get(std::forward<decltype(ts_inner)>(ts_inner)...); }, std::forward<Ts>(ts)...);
 }
 
 // Get callback methods
 template <typename Then, typename... Ts>
 // NOLINTNEXTLINE(fuchsia-trailing-return)
-auto GetCallback(Then then, Ts... ts) {
-    return cpr::async<true>([](Then then_inner, Ts... ts_inner) { return then_inner(Get(std::move(ts_inner)...)); }, std::move(then), std::move(ts)...);
+auto GetCallback(Then&& then, Ts&&... ts) {
+    return cpr::async<true>([](auto&& then_inner, auto&&... ts_inner) { return then_inner(Get(std::forward<decltype(ts_inner)>(ts_inner)...)); }, std::forward<Then>(then), std::forward<Ts>(ts)...);
 }
 
 // Post methods
@@ -144,15 +148,15 @@ Response Post(Ts&&... ts) {
 
 // Post async methods
 template <typename... Ts>
-AsyncResponse PostAsync(Ts... ts) {
-    return cpr::async([](Ts... ts_inner) { return Post(std::move(ts_inner)...); }, std::move(ts)...);
+AsyncResponse PostAsync(Ts&&... ts) {
+    return cpr::async([](auto&&... ts_inner) { return Post(std::forward<decltype(ts_inner)>(ts_inner)...); }, std::forward<Ts>(ts)...);
 }
 
 // Post callback methods
 template <typename Then, typename... Ts>
 // NOLINTNEXTLINE(fuchsia-trailing-return)
-auto PostCallback(Then then, Ts... ts) {
-    return cpr::async<true>([](Then then_inner, Ts... ts_inner) { return then_inner(Post(std::move(ts_inner)...)); }, std::move(then), std::move(ts)...);
+auto PostCallback(Then&& then, Ts&&... ts) {
+    return cpr::async<true>([](auto&& then_inner, auto&&... ts_inner) { return then_inner(Post(std::forward<decltype(ts_inner)>(ts_inner)...)); }, std::forward<Then>(then), std::forward<Ts>(ts)...);
 }
 
 // Put methods
@@ -165,15 +169,15 @@ Response Put(Ts&&... ts) {
 
 // Put async methods
 template <typename... Ts>
-AsyncResponse PutAsync(Ts... ts) {
-    return cpr::async([](Ts... ts_inner) { return Put(std::move(ts_inner)...); }, std::move(ts)...);
+AsyncResponse PutAsync(Ts&&... ts) {
+    return cpr::async([](auto&&... ts_inner) { return Put(std::forward<decltype(ts_inner)>(ts_inner)...); }, std::forward<Ts>(ts)...);
 }
 
 // Put callback methods
 template <typename Then, typename... Ts>
 // NOLINTNEXTLINE(fuchsia-trailing-return)
-auto PutCallback(Then then, Ts... ts) {
-    return cpr::async<true>([](Then then_inner, Ts... ts_inner) { return then_inner(Put(std::move(ts_inner)...)); }, std::move(then), std::move(ts)...);
+auto PutCallback(Then&& then, Ts&&... ts) {
+    return cpr::async<true>([](auto&& then_inner, auto&&... ts_inner) { return then_inner(Put(std::forward<decltype(ts_inner)>(ts_inner)...)); }, std::forward<Then>(then), std::forward<Ts>(ts)...);
 }
 
 // Head methods
@@ -186,15 +190,15 @@ Response Head(Ts&&... ts) {
 
 // Head async methods
 template <typename... Ts>
-AsyncResponse HeadAsync(Ts... ts) {
-    return cpr::async([](Ts... ts_inner) { return Head(std::move(ts_inner)...); }, std::move(ts)...);
+AsyncResponse HeadAsync(Ts&&... ts) {
+    return cpr::async([](auto&&... ts_inner) { return Head(std::forward<decltype(ts_inner)>(ts_inner)...); }, std::forward<Ts>(ts)...);
 }
 
 // Head callback methods
 template <typename Then, typename... Ts>
 // NOLINTNEXTLINE(fuchsia-trailing-return)
-auto HeadCallback(Then then, Ts... ts) {
-    return cpr::async<true>([](Then then_inner, Ts... ts_inner) { return then_inner(Head(std::move(ts_inner)...)); }, std::move(then), std::move(ts)...);
+auto HeadCallback(Then&& then, Ts&&... ts) {
+    return cpr::async<true>([](auto&& then_inner, auto&&... ts_inner) { return then_inner(Head(std::forward<decltype(ts_inner)>(ts_inner)...)); }, std::forward<Then>(then), std::forward<Ts>(ts)...);
 }
 
 // Delete methods
@@ -207,15 +211,15 @@ Response Delete(Ts&&... ts) {
 
 // Delete async methods
 template <typename... Ts>
-AsyncResponse DeleteAsync(Ts... ts) {
-    return cpr::async([](Ts... ts_inner) { return Delete(std::move(ts_inner)...); }, std::move(ts)...);
+AsyncResponse DeleteAsync(Ts&&... ts) {
+    return cpr::async([](auto&&... ts_inner) { return Delete(std::forward<decltype(ts_inner)>(ts_inner)...); }, std::forward<Ts>(ts)...);
 }
 
 // Delete callback methods
 template <typename Then, typename... Ts>
 // NOLINTNEXTLINE(fuchsia-trailing-return)
-auto DeleteCallback(Then then, Ts... ts) {
-    return cpr::async<true>([](Then then_inner, Ts... ts_inner) { return then_inner(Delete(std::move(ts_inner)...)); }, std::move(then), std::move(ts)...);
+auto DeleteCallback(Then&& then, Ts&&... ts) {
+    return cpr::async<true>([](auto&& then_inner, auto&&... ts_inner) { return then_inner(Delete(std::forward<decltype(ts_inner)>(ts_inner)...)); }, std::forward<Then>(then), std::forward<Ts>(ts)...);
 }
 
 // Options methods
@@ -228,15 +232,15 @@ Response Options(Ts&&... ts) {
 
 // Options async methods
 template <typename... Ts>
-AsyncResponse OptionsAsync(Ts... ts) {
-    return cpr::async([](Ts... ts_inner) { return Options(std::move(ts_inner)...); }, std::move(ts)...);
+AsyncResponse OptionsAsync(Ts&&... ts) {
+    return cpr::async([](auto&&... ts_inner) { return Options(std::forward<decltype(ts_inner)>(ts_inner)...); }, std::forward<Ts>(ts)...);
 }
 
 // Options callback methods
 template <typename Then, typename... Ts>
 // NOLINTNEXTLINE(fuchsia-trailing-return)
-auto OptionsCallback(Then then, Ts... ts) {
-    return cpr::async<true>([](Then then_inner, Ts... ts_inner) { return then_inner(Options(std::move(ts_inner)...)); }, std::move(then), std::move(ts)...);
+auto OptionsCallback(Then&& then, Ts&&... ts) {
+    return cpr::async<true>([](auto&& then_inner, auto&&... ts_inner) { return then_inner(Options(std::forward<decltype(ts_inner)>(ts_inner)...)); }, std::forward<Then>(then), std::forward<Ts>(ts)...);
 }
 
 // Patch methods
@@ -249,15 +253,15 @@ Response Patch(Ts&&... ts) {
 
 // Patch async methods
 template <typename... Ts>
-AsyncResponse PatchAsync(Ts... ts) {
-    return cpr::async([](Ts... ts_inner) { return Patch(std::move(ts_inner)...); }, std::move(ts)...);
+AsyncResponse PatchAsync(Ts&&... ts) {
+    return cpr::async([](auto&&... ts_inner) { return Patch(std::forward<decltype(ts_inner)>(ts_inner)...); }, std::forward<Ts>(ts)...);
 }
 
 // Patch callback methods
 template <typename Then, typename... Ts>
 // NOLINTNEXTLINE(fuchsia-trailing-return)
-auto PatchCallback(Then then, Ts... ts) {
-    return cpr::async<true>([](Then then_inner, Ts... ts_inner) { return then_inner(Patch(std::move(ts_inner)...)); }, std::move(then), std::move(ts)...);
+auto PatchCallback(Then&& then, Ts&&... ts) {
+    return cpr::async<true>([](auto&& then_inner, auto&&... ts_inner) { return then_inner(Patch(std::forward<decltype(ts_inner)>(ts_inner)...)); }, std::forward<Then>(then), std::forward<Ts>(ts)...);
 }
 
 // Download methods
@@ -270,14 +274,14 @@ Response Download(std::ofstream& file, Ts&&... ts) {
 
 // Download async method
 template <typename... Ts>
-AsyncResponse DownloadAsync(fs::path local_path, Ts... ts) {
+AsyncResponse DownloadAsync(fs::path local_path, Ts&&... ts) {
     return AsyncWrapper{std::async(
             std::launch::async,
-            [](fs::path local_path_, Ts... ts_) {
+            [](fs::path local_path_, auto&&... ts_) {
                 std::ofstream f(local_path_.c_str());
-                return Download(f, std::move(ts_)...);
+                return Download(f, std::forward<decltype(ts_)>(ts_)...);
             },
-            std::move(local_path), std::move(ts)...)};
+            std::move(local_path), std::forward<Ts>(ts)...)};
 }
 
 // Download with user callback
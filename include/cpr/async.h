@@ -1,12 +1,27 @@
 #ifndef CPR_ASYNC_H
 #define CPR_ASYNC_H
 
+#include <chrono>
+#include <functional>
+#include <type_traits>
+#include <utility>
+
 #include "async_wrapper.h"
+#include "response.h"
 #include "singleton.h"
 #include "threadpool.h"
 
 namespace cpr {
 
+namespace priv {
+/**
+ * Returns the time passed since the given point in time, e.g. the time a task spent waiting inside the thread pool.
+ **/
+inline std::chrono::microseconds elapsed_since(std::chrono::steady_clock::time_point start) {
+    return std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start);
+}
+} // namespace priv
+
 class GlobalThreadPool : public ThreadPool {
     CPR_SINGLETON_DECL(GlobalThreadPool)
   protected:
@@ -24,7 +39,28 @@ class GlobalThreadPool : public ThreadPool {
  **/
 template <bool isCancellable = false, class Fn, class... Args>
 auto async(Fn&& fn, Args&&... args) {
-    std::future future = GlobalThreadPool::GetInstance()->Submit(std::forward<Fn>(fn), std::forward<Args>(args)...);
+    auto submit = [&]() {
+        if constexpr (std::is_same_v<task_result_t<Fn, Args...>, Response>) {
+            // Record the time the request spent waiting for a free thread
+            return GlobalThreadPool::GetInstance()->Submit(
+                    [submitted = std::chrono::steady_clock::now(), inner_fn = std::forward<Fn>(fn)](auto&&... inner_args) mutable -> Response {
+                        const std::chrono::microseconds queue = priv::elapsed_since(submitted);
+                        Response response = [&]() {
+                            if constexpr (task_takes_rvalues_v<Fn, Args...>) {
+                                return std::invoke(inner_fn, std::forward<decltype(inner_args)>(inner_args)...);
+                            } else {
+                                return std::invoke(inner_fn, inner_args...);
+                            }
+                        }();
+                        response.timings.queue += queue;
+                        return response;
+                    },
+                    std::forward<Args>(args)...);
+        } else {
+            return GlobalThreadPool::GetInstance()->Submit(std::forward<Fn>(fn), std::forward<Args>(args)...);
+        }
+    };
+    std::future future = submit();
     using async_wrapper_t = AsyncWrapper<decltype(future.get()), isCancellable>;
     if constexpr (isCancellable) {
         return async_wrapper_t{std::move(future), std::make_shared<std::atomic_bool>(false)};
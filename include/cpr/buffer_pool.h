@@ -0,0 +1,77 @@
+#ifndef CPR_BUFFER_POOL_H
+#define CPR_BUFFER_POOL_H
+
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace cpr {
+/**
+ * Pool of string buffers recycled between responses.
+ *
+ * By default each request allocates and grows fresh buffers for the body and header since the previous ones have been moved into the Response.
+ * With a BufferPool set, the body and header buffers of a Response get returned to the pool once the Response gets destroyed.
+ * The next request then reuses their capacity instead of reallocating while receiving data.
+ *
+ * Copies of a BufferPool share the same buffers, so one pool can be used by multiple sessions and threads.
+ *
+ * Example:
+ * ```cpp
+ * cpr::BufferPool pool;
+ * cpr::Session session;
+ * session.SetUrl(cpr::Url{"http://example.com/api/data"});
+ * session.SetBufferPool(pool);
+ * for (size_t i = 0; i < 1000; i++) {
+ *     cpr::Response r = session.Get();
+ *     ...
+ * } // The buffers of r get returned to the pool here
+ * ```
+ **/
+class BufferPool {
+  public:
+    static constexpr size_t DEFAULT_MAX_BUFFERS{16};
+    static constexpr size_t DEFAULT_MAX_CAPACITY{16 * 1024 * 1024};
+
+    /**
+     * max_buffers: The maximum number of buffers kept inside the pool.
+     * max_capacity: Buffers with a larger capacity get freed instead of being kept, so a single large response does not pin its memory.
+     **/
+    explicit BufferPool(size_t max_buffers = DEFAULT_MAX_BUFFERS, size_t max_capacity = DEFAULT_MAX_CAPACITY);
+
+    /**
+     * Copy constructor - creates a new buffer pool sharing the same buffers.
+     **/
+    BufferPool(const BufferPool&) = default;
+    BufferPool& operator=(const BufferPool&) = delete;
+
+    /**
+     * Returns an empty buffer. Reuses a previously released buffer in case one is available.
+     **/
+    [[nodiscard]] std::string Acquire() const;
+
+    /**
+     * Hands the given buffer back to the pool.
+     * The buffer gets freed in case the pool is full or the buffer is too small or too large to be worth keeping.
+     **/
+    void Release(std::string&& buffer) const;
+
+    /**
+     * Returns the number of buffers currently kept inside the pool.
+     **/
+    [[nodiscard]] size_t GetSize() const;
+
+  private:
+    struct State {
+        std::mutex mutex;
+        std::vector<std::string> buffers;
+        size_t max_buffers;
+        size_t max_capacity;
+    };
+
+    std::shared_ptr<State> state_;
+};
+} // namespace cpr
+
+#endif
@@ -58,6 +58,9 @@ class ConnectionPool {
     void SetupHandler(CURL* easy_handler) const;
 
   private:
+    // Shares cookies through the same CURLSH handle, see CookieJar(const ConnectionPool&)
+    friend class CookieJar;
+
     /**
      * Thread-safe mutex used for synchronizing access to shared connections.
      * This mutex is passed to libcurl's locking callbacks to ensure thread safety
@@ -0,0 +1,73 @@
+#ifndef CPR_CONTENT_DECODER_H
+#define CPR_CONTENT_DECODER_H
+
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <curl/curl.h>
+
+namespace cpr::util {
+
+/**
+ * Decodes response bodies with a content encoding libcurl has not been built with (see AcceptEncoding).
+ *
+ * Supports gzip and deflate in case cpr has been built with zlib, zstd with libzstd and br with the brotli decoder.
+ * The data gets decoded into a buffer of BUFFER_SIZE bytes, which gets handed to the write function every time it is full,
+ * so the decoded body is never held in memory as a whole by the decoder.
+ **/
+class ContentDecoder {
+  public:
+    static constexpr size_t BUFFER_SIZE{16 * 1024};
+
+    /**
+     * handle and raw_header belong to the session performing the request.
+     * They are used for looking up the 'Content-Encoding' of the response once its body starts.
+     * write: Receives the decoded data. Has to return the number of bytes consumed.
+     **/
+    ContentDecoder(CURL* handle, const std::string* raw_header, std::function<size_t(char* data, size_t size)> write);
+    /**
+     * Decodes the given content encoding, independent of any response.
+     * Throws std::invalid_argument in case the encoding is not supported.
+     **/
+    ContentDecoder(std::string_view encoding, std::function<size_t(char* data, size_t size)> write);
+    ContentDecoder(const ContentDecoder& other) = delete;
+    ContentDecoder(ContentDecoder&& old) = delete;
+    ContentDecoder& operator=(const ContentDecoder& other) = delete;
+    ContentDecoder& operator=(ContentDecoder&& old) = delete;
+    ~ContentDecoder();
+
+    /**
+     * Decodes the given part of the body and passes it on.
+     * Returns data.size() on success and 0 in case the data could not be decoded or the write function failed.
+     **/
+    size_t Write(std::string_view data);
+
+    /**
+     * Returns true in case the decoder supports the given content encoding, e.g. "br".
+     **/
+    [[nodiscard]] static bool IsSupported(std::string_view encoding);
+
+    /**
+     * Decompressor for a single content encoding, implemented for each library.
+     **/
+    class Decompressor;
+
+  private:
+    bool begin();
+    bool selectDecompressor(std::string_view encoding);
+
+    CURL* handle_{nullptr};
+    const std::string* raw_header_{nullptr};
+    std::function<size_t(char* data, size_t size)> write_;
+    std::unique_ptr<Decompressor> decompressor_;
+    std::vector<char> buffer_;
+    bool started_{false};
+};
+
+} // namespace cpr::util
+
+#endif
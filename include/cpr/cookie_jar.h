@@ -0,0 +1,89 @@
+#ifndef CPR_COOKIE_JAR_H
+#define CPR_COOKIE_JAR_H
+
+#include <curl/curl.h>
+#include <memory>
+#include <mutex>
+
+#include "cpr/connection_pool.h"
+#include "cpr/cookies.h"
+#include "cpr/curlholder.h"
+
+namespace cpr {
+/**
+ * Cookie store shared between sessions, based on libcurl's cookie engine and its CURLSH (share) interface.
+ *
+ * All sessions using the same jar send and receive cookies from a single store. Cookies received via 'Set-Cookie'
+ * get added to it as responses arrive, including responses to redirects, and each request only looks up the cookies
+ * matching its host and path. libcurl keeps the cookies hashed by domain and drops expired ones lazily on lookup,
+ * so the cost of a request does not grow with cookies stored for other domains.
+ * Access to the store is synchronized, so a jar can be used from multiple threads at once.
+ *
+ * A session can only use a single share. To share connections as well, create the jar from the ConnectionPool
+ * before the pool is used by any session and set the pool (or the jar) on the sessions.
+ *
+ * Copies share the same store.
+ *
+ * Example:
+ * ```cpp
+ * cpr::CookieJar jar;
+ * jar.Add(cpr::Cookie{"token", "abc", "example.com", true});
+ *
+ * cpr::Response r1 = cpr::Get(cpr::Url{"http://example.com/login"}, jar);
+ * // Sends the token and all cookies set by the first response
+ * cpr::Response r2 = cpr::Get(cpr::Url{"http://api.example.com/data"}, jar);
+ * ```
+ **/
+class CookieJar {
+  public:
+    CookieJar();
+    /**
+     * Shares the cookies through the given pool, so sessions using the pool share connections and cookies.
+     * Throws std::invalid_argument in case the pool is already in use.
+     **/
+    explicit CookieJar(const ConnectionPool& pool);
+    CookieJar(const CookieJar& other) = default;
+    CookieJar& operator=(const CookieJar& other) = delete;
+
+    /**
+     * Adds the given cookie, replacing an existing one with the same name, domain and path.
+     * Throws std::invalid_argument in case the cookie has no domain.
+     **/
+    void Add(const Cookie& cookie);
+    void Add(const Cookies& cookies);
+    /**
+     * Returns all cookies currently stored.
+     **/
+    [[nodiscard]] Cookies GetCookies() const;
+    /**
+     * Removes all cookies.
+     **/
+    void Clear();
+    /**
+     * Removes all cookies without an expiry date.
+     **/
+    void ClearSessionCookies();
+
+    /**
+     * Returns true in case the jar has been created from the given pool (or a copy of it), so both use the same share.
+     **/
+    [[nodiscard]] bool IsSharedWith(const ConnectionPool& pool) const;
+
+    /**
+     * Configures the given handle to use the jar.
+     **/
+    void SetupHandler(CURL* easy_handler) const;
+
+  private:
+    void setList(const char* command) const;
+
+    // Declared first, so it gets destroyed after the share referencing it
+    std::shared_ptr<std::mutex> share_mutex_;
+    std::shared_ptr<CURLSH> curl_sh_;
+    // Attached to the share for adding and listing cookies. Destroyed before the share.
+    std::shared_ptr<CurlHolder> holder_;
+    std::shared_ptr<std::mutex> holder_mutex_;
+};
+} // namespace cpr
+
+#endif
@@ -2,8 +2,11 @@
 #define CPR_COOKIES_H
 
 #include "cpr/curlholder.h"
+#include <atomic>
 #include <chrono>
 #include <initializer_list>
+#include <memory>
+#include <mutex>
 #include <string>
 #include <vector>
 
@@ -63,9 +66,25 @@ class Cookies {
     Cookies(bool p_encode = true) : encode{p_encode} {}
     Cookies(const std::initializer_list<cpr::Cookie>& cookies, bool p_encode = true) : encode{p_encode}, cookies_{cookies} {}
     Cookies(const cpr::Cookie& cookie, bool p_encode = true) : encode{p_encode}, cookies_{cookie} {}
+    /**
+     * Takes a cookie list as returned by CURLINFO_COOKIELIST.
+     * The list only gets parsed on first access of the cookies.
+     **/
+    explicit Cookies(std::shared_ptr<curl_slist> raw_cookies, bool p_encode = true) : encode{p_encode}, rawCookies_{std::move(raw_cookies)}, pending_{rawCookies_ != nullptr} {}
+    Cookies(const Cookies& other);
+    Cookies(Cookies&& old) noexcept;
+    ~Cookies() = default;
+
+    Cookies& operator=(const Cookies& other);
+    Cookies& operator=(Cookies&& old) noexcept;
 
     cpr::Cookie& operator[](size_t pos);
+    /**
+     * Returns the cookies in the format of the 'Cookie' header, URL encoded in case `encode` is set.
+     * The `CurlHolder` is not required for encoding any more and only kept for compatibility.
+     **/
     [[nodiscard]] std::string GetEncoded(const CurlHolder& holder) const;
+    [[nodiscard]] std::string GetEncoded() const;
 
     using iterator = std::vector<cpr::Cookie>::iterator;
     using const_iterator = std::vector<cpr::Cookie>::const_iterator;
@@ -82,7 +101,34 @@ class Cookies {
     void pop_back();
 
   private:
-    std::vector<cpr::Cookie> cookies_;
+    /**
+     * Parses rawCookies_ into cookies_ in case this did not happen yet.
+     **/
+    void parse() const;
+    /**
+     * Return the cookies after parsing them (see parse()).
+     **/
+    std::vector<cpr::Cookie>& get();
+    [[nodiscard]] const std::vector<cpr::Cookie>& get() const;
+
+    mutable std::vector<cpr::Cookie> cookies_;
+    // Unparsed cookie list. Guarded by mutex_ since it gets parsed from const member functions.
+    mutable std::shared_ptr<curl_slist> rawCookies_;
+    mutable std::atomic_bool pending_{false};
+    mutable std::mutex mutex_;
+};
+
+/**
+ * Enables or disables the libcurl cookie engine of a session. The engine is enabled by default.
+ * With the engine disabled, cookies received are neither stored nor sent with following requests and Response::cookies stays empty.
+ * Cookies set via Session::SetCookies(...) are sent in both cases.
+ **/
+class CookieEngine {
+  public:
+    CookieEngine() = default;
+    CookieEngine(const bool p_enabled) : enabled{p_enabled} {}
+
+    bool enabled = true;
 };
 } // namespace cpr
 
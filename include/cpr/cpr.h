@@ -4,16 +4,20 @@
 #include "cpr/api.h"
 #include "cpr/auth.h"
 #include "cpr/bearer.h"
+#include "cpr/buffer_pool.h"
 #include "cpr/callback.h"
 #include "cpr/cert_info.h"
 #include "cpr/connect_timeout.h"
 #include "cpr/connection_pool.h"
+#include "cpr/cookie_jar.h"
 #include "cpr/cookies.h"
 #include "cpr/cprtypes.h"
 #include "cpr/cprver.h"
 #include "cpr/curl_container.h"
 #include "cpr/curlholder.h"
 #include "cpr/error.h"
+#include "cpr/file_body.h"
+#include "cpr/file_sink.h"
 #include "cpr/http_version.h"
 #include "cpr/interceptor.h"
 #include "cpr/interface.h"
@@ -23,22 +27,32 @@
 #include "cpr/low_speed.h"
 #include "cpr/multipart.h"
 #include "cpr/multiperform.h"
+#include "cpr/parallel_download.h"
 #include "cpr/parameters.h"
 #include "cpr/payload.h"
+#include "cpr/payload_stream.h"
 #include "cpr/proxies.h"
 #include "cpr/proxyauth.h"
 #include "cpr/range.h"
 #include "cpr/redirect.h"
+#include "cpr/request_arena.h"
+#include "cpr/request_compression.h"
 #include "cpr/reserve_size.h"
 #include "cpr/resolve.h"
 #include "cpr/response.h"
+#include "cpr/response_fields.h"
+#include "cpr/response_header.h"
+#include "cpr/response_sink.h"
+#include "cpr/resumable_download.h"
 #include "cpr/session.h"
 #include "cpr/sse.h"
 #include "cpr/ssl_ctx.h"
 #include "cpr/ssl_options.h"
 #include "cpr/status_codes.h"
 #include "cpr/timeout.h"
+#include "cpr/timings.h"
 #include "cpr/unix_socket.h"
+#include "cpr/url_encode.h"
 #include "cpr/user_agent.h"
 #include "cpr/util.h"
 #include "cpr/verbose.h"
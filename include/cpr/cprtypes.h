@@ -100,6 +100,9 @@ class StringHolder {
     bool operator==(const std::string& rhs) const {
         return str_ == rhs;
     }
+    bool operator==(std::string_view rhs) const {
+        return str_ == rhs;
+    }
     bool operator==(const StringHolder<T>& rhs) const {
         return str_ == rhs.str_;
     }
@@ -110,6 +113,9 @@ class StringHolder {
     bool operator!=(const std::string& rhs) const {
         return str_ != rhs;
     }
+    bool operator!=(std::string_view rhs) const {
+        return str_ != rhs;
+    }
     bool operator!=(const StringHolder<T>& rhs) const {
         return str_ != rhs.str_;
     }
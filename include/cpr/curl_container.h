@@ -3,7 +3,11 @@
 
 #include <initializer_list>
 #include <memory>
+#include <memory_resource>
+#include <mutex>
+#include <optional>
 #include <string>
+#include <utility>
 #include <vector>
 
 #include "cpr/curlholder.h"
@@ -41,8 +45,9 @@ class CurlContainer {
     void Add(const T& /*element*/);
 
     /**
-     * Returns the URL using curl_easy_escape(...) for escaping the given parameters.
-     * Requires `CurlHolder`.
+     * Returns the URL, escaping the given parameters in case `encode` is set (see util::urlEncode(...)).
+     * The `CurlHolder` is not required for escaping any more and only kept for compatibility.
+     * The result gets cached until the container is modified, so calling it for every request is cheap.
      **/
     [[nodiscard]] const std::string GetContent(const CurlHolder& /*holder*/) const;
 
@@ -52,8 +57,64 @@ class CurlContainer {
      **/
     [[nodiscard]] const std::string GetContent() const;
 
+    /**
+     * Like GetContent(holder), but the returned copy gets allocated from the given resource (e.g. a RequestArena).
+     **/
+    [[nodiscard]] std::pmr::string GetContent(const CurlHolder& /*holder*/, std::pmr::memory_resource* resource) const;
+
   protected:
     std::vector<T> containerList_;
+
+  private:
+    /**
+     * The content last returned by GetContent(...).
+     * Guarded by a mutex, since it gets filled by const member functions.
+     **/
+    struct ContentCache {
+        ContentCache() = default;
+        ContentCache(const ContentCache& other) : content(other.Get()) {}
+        ContentCache(ContentCache&& old) noexcept : content(old.Take()) {}
+        ~ContentCache() = default;
+        ContentCache& operator=(const ContentCache& other) {
+            if (&other != this) {
+                std::optional<std::pair<std::string, bool>> copy = other.Get();
+                const std::lock_guard lock(mutex);
+                content = std::move(copy);
+            }
+            return *this;
+        }
+        ContentCache& operator=(ContentCache&& old) noexcept {
+            if (&old != this) {
+                std::optional<std::pair<std::string, bool>> taken = old.Take();
+                const std::lock_guard lock(mutex);
+                content = std::move(taken);
+            }
+            return *this;
+        }
+
+        [[nodiscard]] std::optional<std::pair<std::string, bool>> Get() const {
+            const std::lock_guard lock(mutex);
+            return content;
+        }
+        std::optional<std::pair<std::string, bool>> Take() {
+            const std::lock_guard lock(mutex);
+            return std::exchange(content, std::nullopt);
+        }
+        void Reset() {
+            const std::lock_guard lock(mutex);
+            content.reset();
+        }
+
+        mutable std::mutex mutex;
+        // The content and whether it has been URL encoded
+        std::optional<std::pair<std::string, bool>> content;
+    };
+
+    [[nodiscard]] const std::string getContent(bool p_encode) const;
+    // Builds the cache in case it does not match p_encode. cache_.mutex has to be locked by the caller.
+    [[nodiscard]] const std::string& cachedContent(bool p_encode) const;
+
+    mutable ContentCache cache_;
 };
 
 } // namespace cpr
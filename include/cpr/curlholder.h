@@ -2,6 +2,7 @@
 #define CPR_CURLHOLDER_H
 
 #include <array>
+#include <cstdint>
 #include <curl/curl.h>
 #include <mutex>
 
@@ -31,6 +32,11 @@ struct CurlHolder {
     struct curl_slist* resolveCurlList{nullptr};
     curl_mime* multipart{nullptr};
     std::array<char, CURL_ERROR_SIZE> error{};
+    /**
+     * Incremented each time a transfer gets prepared on the handle.
+     * Responses record it, since the handle only describes the latest transfer (see Response::LoadFields(...)).
+     **/
+    std::uint64_t generation{0};
 
     CurlHolder();
     CurlHolder(const CurlHolder& other) = delete;
@@ -41,12 +47,13 @@ struct CurlHolder {
     CurlHolder& operator=(CurlHolder&& old) noexcept;
 
     /**
-     * Uses curl_easy_escape(...) for escaping the given string.
+     * Escapes the given string like curl_easy_escape(...) would.
+     * Does not require the handle, see util::urlEncode(...) for variants not returning a SecureString.
      **/
     [[nodiscard]] util::SecureString urlEncode(std::string_view s) const;
 
     /**
-     * Uses curl_easy_unescape(...) for unescaping the given string.
+     * Unescapes the given string like curl_easy_unescape(...) would.
      **/
     [[nodiscard]] util::SecureString urlDecode(std::string_view s) const;
 };
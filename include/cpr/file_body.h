@@ -0,0 +1,73 @@
+#ifndef CPR_FILE_BODY_H
+#define CPR_FILE_BODY_H
+
+#include <cstddef>
+#include <cstdio>
+#include <memory>
+#include <string>
+
+#include "cpr/cprtypes.h"
+#include "cpr/file.h"
+
+namespace cpr {
+
+/**
+ * Request body streamed from a file while it gets uploaded.
+ *
+ * In contrast to Body(const File&), the file does not get read into memory up front.
+ * Instead, libcurl reads it in large sequential chunks straight into its upload buffer.
+ * This way the memory required for an upload stays constant, independent of the file size.
+ * The 'Content-Length' gets set to the size of the file.
+ *
+ * The file gets opened on construction, so copies share the same file handle.
+ * Therefore a FileBody must not be used by multiple requests running at the same time.
+ *
+ * Example:
+ * ```cpp
+ * cpr::Response r = cpr::Post(cpr::Url{"http://example.com/upload"}, cpr::FileBody{"backup.tar"});
+ * ```
+ **/
+class FileBody {
+  public:
+    /**
+     * Size of the chunks requested from libcurl while uploading.
+     **/
+    static constexpr size_t READ_SIZE{512 * 1024};
+
+    /**
+     * Throws std::invalid_argument in case the file can not be opened.
+     **/
+    explicit FileBody(std::string filepath);
+    // NOLINTNEXTLINE (google-explicit-constructor, hicpp-explicit-conversions)
+    FileBody(const File& file);
+
+    [[nodiscard]] const std::string& GetPath() const;
+    /**
+     * Returns the size of the file at the time it got opened.
+     **/
+    [[nodiscard]] cpr_off_t GetSize() const;
+
+    /**
+     * Reads up to size bytes into the given buffer at the current position.
+     * Returns the number of bytes read, which is 0 once the end of the file has been reached.
+     **/
+    size_t Read(char* buffer, size_t size) const;
+    /**
+     * Moves the read position to the given offset from the beginning of the file.
+     * Returns false in case this failed.
+     **/
+    bool Seek(cpr_off_t offset) const;
+    /**
+     * Returns true in case a previous read failed.
+     **/
+    [[nodiscard]] bool HasError() const;
+
+  private:
+    std::string filepath_;
+    std::shared_ptr<std::FILE> file_;
+    cpr_off_t size_{0};
+};
+
+} // namespace cpr
+
+#endif
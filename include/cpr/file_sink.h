@@ -0,0 +1,88 @@
+#ifndef CPR_FILE_SINK_H
+#define CPR_FILE_SINK_H
+
+#include <cstddef>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "cpr/cprtypes.h"
+#include "cpr/response_sink.h"
+
+namespace cpr {
+
+/**
+ * Writes the body straight into a file descriptor.
+ *
+ * Chunks received from libcurl get collected in a buffer and written with a single positional write (pwrite) once it is full.
+ * This way large downloads end up as a few large writes instead of one iostream write per chunk.
+ * The file gets written in whole buffers at buffer aligned offsets (relative to where the sink started writing),
+ * except for the rest written by Flush(), which moves all following writes off the alignment.
+ * On Linux the file gets preallocated as soon as the 'Content-Length' of the response is known.
+ * The data only gets synced to disk on Flush() in case this got requested on construction.
+ *
+ * The file gets created or truncated on construction and closed when the sink is destroyed.
+ *
+ * Example:
+ * ```cpp
+ * auto sink = std::make_shared<cpr::FileSink>("large.iso");
+ * cpr::Session session;
+ * session.SetUrl(cpr::Url{"http://xxx/large.iso"});
+ * cpr::Response r = session.Download(sink);
+ * ```
+ **/
+class FileSink : public ResponseSink {
+  public:
+    static constexpr size_t DEFAULT_BUFFER_SIZE{1024 * 1024};
+
+    /**
+     * Throws std::system_error holding the errno in case the file can not be opened and std::invalid_argument in case buffer_size is zero.
+     * In case sync is true, Flush() waits until the data has been written to disk.
+     * In case append is true, the existing content of the file is kept and new data gets written behind it.
+     * Clear() then only discards the data written by the sink and GetSize()/GetString() include the existing content.
+     **/
+    explicit FileSink(std::string filepath, size_t buffer_size = DEFAULT_BUFFER_SIZE, bool sync = false, bool append = false);
+    FileSink(const FileSink& other) = delete;
+    FileSink(FileSink&& old) = delete;
+    ~FileSink() override;
+
+    FileSink& operator=(const FileSink& other) = delete;
+    FileSink& operator=(FileSink&& old) = delete;
+
+    size_t Write(std::string_view data) override;
+    void Reserve(size_t size) override;
+    void Clear() override;
+    bool Flush() override;
+    [[nodiscard]] size_t GetSize() const override;
+    /**
+     * Reads the whole file back into memory.
+     **/
+    [[nodiscard]] std::string GetString() const override;
+
+    /**
+     * Writes the given data at the given offset of the file, bypassing the buffer.
+     * Allows filling the file out of order, e.g. with multiple ranges downloaded in parallel.
+     * Returns the number of bytes written, which is less than data.size() in case writing failed.
+     **/
+    size_t WriteAt(cpr_off_t offset, std::string_view data);
+
+    [[nodiscard]] const std::string& GetPath() const;
+
+  private:
+    bool flushBuffer();
+
+    std::string filepath_;
+    int fd_{-1};
+    bool sync_;
+    // Size of the content the file had when it got opened for appending
+    size_t kept_size_{0};
+    std::vector<char> buffer_;
+    size_t buffered_{0};
+    // Offset inside the file the buffer gets written to
+    size_t buffer_offset_{0};
+    size_t size_{0};
+};
+
+} // namespace cpr
+
+#endif
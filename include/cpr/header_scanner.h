@@ -0,0 +1,42 @@
+#ifndef CPR_HEADER_SCANNER_H
+#define CPR_HEADER_SCANNER_H
+
+#include <cstddef>
+#include <string_view>
+#include <vector>
+
+namespace cpr::util {
+
+/**
+ * Position of a single line inside a raw header block.
+ **/
+struct HeaderLine {
+    // Offset of the first character of the line
+    size_t start;
+    // Offset of the first colon inside the line or std::string_view::npos in case there is none
+    size_t colon;
+    // Offset of the terminating line feed or the size of the block for the last, unterminated line
+    size_t end;
+
+    bool operator==(const HeaderLine& other) const {
+        return start == other.start && colon == other.colon && end == other.end;
+    }
+};
+
+/**
+ * Locates the end and the first colon of the line starting at the given offset, which has to be less than data.size().
+ * The next line starts at end + 1. Allows processing the lines of a block without collecting them first.
+ **/
+HeaderLine scanHeaderLine(std::string_view data, size_t start);
+
+/**
+ * Splits the given header block into lines and locates the first colon of each line.
+ * Both searches use memchr, which the C library already vectorizes and dispatches at runtime for the current CPU.
+ * The colon search is limited to the line and usually stops after the short field name.
+ * The lines get appended to the given vector.
+ **/
+void scanHeaderLines(std::string_view data, std::vector<HeaderLine>& lines);
+
+} // namespace cpr::util
+
+#endif
@@ -3,9 +3,11 @@
 
 #include "cpr/curlmultiholder.h"
 #include "cpr/response.h"
+#include "cpr/response_fields.h"
 #include "cpr/session.h"
 #include <functional>
 #include <memory>
+#include <optional>
 #include <queue>
 #include <stdexcept>
 #include <vector>
@@ -57,6 +59,12 @@ class MultiPerform {
 
     void AddInterceptor(const std::shared_ptr<InterceptorMulti>& pinterceptor);
 
+    /**
+     * Selects the metadata filled into the responses of all sessions, including the ones added later.
+     * See Session::SetResponseFields(...).
+     **/
+    void SetResponseFields(ResponseFields fields);
+
   private:
     // Interceptors should be able to call the private proceed() and PrepareDownloadSessions() functions
     friend InterceptorMulti;
@@ -70,6 +78,7 @@ class MultiPerform {
     void PrepareDownloadSessions(size_t sessions_index, const CurrentDownloadArgType& current_arg);
     void PrepareDownloadSession(size_t sessions_index, std::ofstream& file);
     void PrepareDownloadSession(size_t sessions_index, const WriteCallback& write);
+    void PrepareDownloadSession(size_t sessions_index, const std::shared_ptr<ResponseSink>& sink);
 
     void PrepareGet();
     void PrepareDelete();
@@ -92,6 +101,7 @@ class MultiPerform {
     std::vector<std::pair<std::shared_ptr<Session>, HttpMethod>> sessions_;
     std::unique_ptr<CurlMultiHolder> multicurl_;
     bool is_download_multi_perform{false};
+    std::optional<ResponseFields> responseFields_;
 
     using InterceptorsContainer = std::list<std::shared_ptr<InterceptorMulti>>;
     InterceptorsContainer interceptors_;
@@ -0,0 +1,69 @@
+#ifndef CPR_PARALLEL_DOWNLOAD_H
+#define CPR_PARALLEL_DOWNLOAD_H
+
+#include <cstddef>
+#include <functional>
+#include <string>
+
+#include "cpr/api.h"
+#include "cpr/connection_pool.h"
+#include "cpr/cprtypes.h"
+#include "cpr/response.h"
+#include "cpr/session.h"
+
+namespace cpr {
+
+/**
+ * Number of times a failed segment of a ParallelDownload(...) gets retried before giving up.
+ * Each retry continues at the first byte of the segment not received yet.
+ **/
+constexpr size_t PARALLEL_DOWNLOAD_RETRIES{3};
+
+/**
+ * Upper limit for the number of segments of a ParallelDownload(...).
+ * Every segment keeps its own easy handle and connection open, so larger values get clamped to this.
+ **/
+constexpr size_t PARALLEL_DOWNLOAD_MAX_SEGMENTS{64};
+
+namespace priv {
+/**
+ * Downloads into the given file with the given number of range requests running concurrently on one multi handle.
+ * setup gets called for every session created, to apply the URL and all other options.
+ **/
+Response parallel_download(const std::string& filepath, size_t segments, const std::function<void(Session&)>& setup);
+} // namespace priv
+
+/**
+ * Downloads a single object split into multiple ranges fetched concurrently.
+ *
+ * First, a HEAD request probes the 'Content-Length' and 'Accept-Ranges' of the object.
+ * The object then gets split into the given number of ranges (at most PARALLEL_DOWNLOAD_MAX_SEGMENTS), which get fetched in parallel on one multi handle.
+ * Every range has to be answered with a 206 status and a matching 'Content-Range', otherwise it counts as failed.
+ * Since ranges refer to the bytes sent, all of these requests ask for the object without content encoding ('Accept-Encoding: identity').
+ * Each range gets written straight to its offset inside the file (see FileSink::WriteAt(...)).
+ * Failed ranges get retried individually (see PARALLEL_DOWNLOAD_RETRIES).
+ * In case the server does not support ranges, does not report the size or encodes the object anyway, it falls back to a single download.
+ *
+ * All requests share the given connection pool. Further options get applied to every request.
+ * Returns the response of the probe request with the size, time and error of the whole download.
+ * The file is available through Response::sink.
+ *
+ * Example:
+ * ```cpp
+ * cpr::Response r = cpr::ParallelDownload(cpr::Url{"http://xxx/large.iso"}, "large.iso", 8, cpr::ConnectionPool{});
+ * ```
+ **/
+template <typename... Ts>
+Response ParallelDownload(const Url& url, const std::string& filepath, size_t segments, const ConnectionPool& pool, const Ts&... ts) {
+    return priv::parallel_download(filepath, segments, [&](Session& session) {
+        session.SetUrl(url);
+        session.SetConnectionPool(pool);
+        if constexpr (sizeof...(Ts) > 0) {
+            priv::set_option(session, ts...);
+        }
+    });
+}
+
+} // namespace cpr
+
+#endif
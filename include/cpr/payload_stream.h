@@ -0,0 +1,100 @@
+#ifndef CPR_PAYLOAD_STREAM_H
+#define CPR_PAYLOAD_STREAM_H
+
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <string>
+#include <string_view>
+
+#include "cpr/cprtypes.h"
+
+namespace cpr {
+
+/**
+ * Form body ('application/x-www-form-urlencoded') encoded pair by pair while it gets uploaded.
+ *
+ * In contrast to Payload, the form never gets encoded as a whole. Instead, libcurl pulls the body through a read callback
+ * and the pairs of the given range get encoded straight into its upload buffer. This way the memory required stays
+ * constant, independent of the number of pairs. Pairs get encoded like by Payload (only the values get URL encoded).
+ *
+ * The elements of the range need a `key` and a `value` convertible to std::string_view, like cpr::Pair.
+ * The range is only referenced, so it has to outlive all requests using it and must not change in between.
+ * Since the body gets sent again on redirects or authentication retries, the iterators have to be forward iterators.
+ *
+ * By default the 'Content-Length' gets computed up front, which requires an additional pass over all pairs without encoding them.
+ * With `chunked` set, chunked transfer encoding gets used instead.
+ *
+ * Copies share the same read position, so a PayloadStream must not be used by multiple requests running at the same time.
+ *
+ * Example:
+ * ```cpp
+ * std::vector<cpr::Pair> pairs = LoadRecords();
+ * cpr::Response r = cpr::Post(cpr::Url{"http://example.com/import"}, cpr::PayloadStream{pairs.begin(), pairs.end()});
+ * ```
+ **/
+class PayloadStream {
+  public:
+    /**
+     * Size of the chunks requested from libcurl while uploading.
+     **/
+    static constexpr size_t READ_SIZE{64 * 1024};
+
+    /**
+     * Receives the key and value of a single pair.
+     **/
+    using PairVisitor = std::function<void(std::string_view key, std::string_view value)>;
+
+    /**
+     * Enables or disables URL encoding of the values.
+     **/
+    bool encode{true};
+    /**
+     * Sends the body using chunked transfer encoding instead of computing its size up front.
+     **/
+    bool chunked{false};
+
+    template <class It>
+    PayloadStream(It begin, It end) {
+        std::shared_ptr<It> current = std::make_shared<It>(begin);
+        next_ = [current, end](const PairVisitor& visit) {
+            if (*current == end) {
+                return false;
+            }
+            // Visit before advancing, so iterators returning temporaries work as well
+            const auto& pair = **current;
+            visit(pair.key, pair.value);
+            ++(*current);
+            return true;
+        };
+        rewind_ = [current, begin]() { *current = begin; };
+    }
+
+    /**
+     * Returns the size of the whole encoded body.
+     * Iterates over all pairs and restarts at the first one afterwards.
+     **/
+    [[nodiscard]] cpr_off_t GetSize();
+
+    /**
+     * Encodes the next pairs into the given buffer.
+     * Returns the number of bytes written, which is 0 once all pairs have been encoded.
+     **/
+    size_t Read(char* buffer, size_t size);
+    /**
+     * Restarts encoding at the first pair.
+     **/
+    void Rewind();
+
+  private:
+    std::function<bool(const PairVisitor& visit)> next_;
+    std::function<void()> rewind_;
+    // Encoded pair that did not fit into the last buffer
+    std::string pending_;
+    size_t pendingOffset_{0};
+    bool first_{true};
+};
+
+} // namespace cpr
+
+#endif
@@ -17,7 +17,7 @@ class EncodedAuthentication {
 
   public:
     EncodedAuthentication() = default;
-    EncodedAuthentication(std::string_view p_username, std::string_view p_password) : username(util::urlEncode(p_username)), password(util::urlEncode(p_password)) {}
+    EncodedAuthentication(std::string_view p_username, std::string_view p_password) : username(util::urlEncodeSecure(p_username)), password(util::urlEncodeSecure(p_password)) {}
     EncodedAuthentication(const EncodedAuthentication& other) = default;
     EncodedAuthentication(EncodedAuthentication&& old) noexcept = default;
     virtual ~EncodedAuthentication() noexcept = default;
@@ -0,0 +1,74 @@
+#ifndef CPR_REQUEST_ARENA_H
+#define CPR_REQUEST_ARENA_H
+
+#include <cstddef>
+#include <memory>
+#include <memory_resource>
+#include <vector>
+
+namespace cpr {
+/**
+ * Arena for the temporaries a Session builds for each request: the header list and the request URL including its encoded parameters.
+ *
+ * By default each header line and each node of the list passed to libcurl gets allocated and freed on its own,
+ * so every line costs two heap allocations per request. The same applies to the copies made to append the parameters to the URL.
+ * With a RequestArena set, they get allocated from a single preallocated buffer instead and stay there until the request completed.
+ * Cookies are not covered, since they get encoded once by Session::SetCookies(...) instead of for each request.
+ * The arena gets reset before each request, so all of them are freed in one step and the buffer is reused by the next request.
+ * In case the buffer is exhausted, further memory is requested from the heap until the next reset.
+ *
+ * Copies of a RequestArena share the same buffer.
+ * Since the arena gets reset on each request, it must not be shared between sessions performing requests concurrently.
+ *
+ * Example:
+ * ```cpp
+ * cpr::Session session;
+ * session.SetUrl(cpr::Url{"http://example.com/api/data"});
+ * session.SetHeader(cpr::Header{{"Accept", "application/json"}});
+ * session.SetRequestArena(cpr::RequestArena{});
+ * for (size_t i = 0; i < 1000; i++) {
+ *     cpr::Response r = session.Get();
+ *     ...
+ * }
+ * ```
+ **/
+class RequestArena {
+  public:
+    static constexpr size_t DEFAULT_INITIAL_SIZE{4096};
+
+    /**
+     * initial_size: Size of the buffer allocated up front. Should cover the header list of a typical request.
+     **/
+    explicit RequestArena(size_t initial_size = DEFAULT_INITIAL_SIZE);
+
+    /**
+     * Copy constructor - creates a new arena sharing the same buffer.
+     **/
+    RequestArena(const RequestArena&) = default;
+    RequestArena& operator=(const RequestArena&) = delete;
+
+    /**
+     * Returns the memory resource to allocate from.
+     * It stays valid for the lifetime of the arena and all of its copies.
+     **/
+    [[nodiscard]] std::pmr::memory_resource* GetResource() const;
+
+    /**
+     * Frees everything allocated from the arena so far.
+     * All objects allocated from GetResource() must have been destroyed before.
+     **/
+    void Release() const;
+
+  private:
+    struct State {
+        explicit State(size_t initial_size);
+
+        std::vector<std::byte> buffer;
+        std::pmr::monotonic_buffer_resource resource;
+    };
+
+    std::shared_ptr<State> state_;
+};
+} // namespace cpr
+
+#endif
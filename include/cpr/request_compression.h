@@ -0,0 +1,139 @@
+#ifndef CPR_REQUEST_COMPRESSION_H
+#define CPR_REQUEST_COMPRESSION_H
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+namespace cpr {
+
+enum class RequestCompressionMethod : uint8_t {
+    /**
+     * Sends the body as it is.
+     **/
+    identity,
+    gzip,
+    zstd,
+};
+
+/**
+ * Compresses the body of requests and sets the matching 'Content-Encoding' header.
+ *
+ * Applies to cpr::Body, cpr::BodyView and cpr::Payload, which get compressed once and reused until the body changes,
+ * as well as to cpr::FileBody and bodies provided through a cpr::ReadCallback. Those get compressed while being sent,
+ * using a buffer of limited size, so they never have to fit into memory. Since their compressed size is unknown up front,
+ * they get sent using chunked transfer encoding. Multipart bodies do not get compressed.
+ *
+ * gzip requires cpr to be built with zlib, zstd requires it to be built with zstd (see IsSupported(...)).
+ * The server has to support the content encoding used, otherwise it will not be able to read the body.
+ *
+ * Example:
+ * ```cpp
+ * cpr::Response r = cpr::Post(cpr::Url{"http://xxx/upload"}, cpr::Body{large_json}, cpr::RequestCompression{cpr::RequestCompressionMethod::zstd});
+ * ```
+ **/
+class RequestCompression {
+  public:
+    /**
+     * method: The content encoding used for the body.
+     * level: The compression level. The default of the library in case it is not set (6 for gzip, 3 for zstd).
+     * dictionary: A zstd dictionary the server knows as well. Only supported by zstd.
+     **/
+    // NOLINTNEXTLINE(google-explicit-constructor, hicpp-explicit-conversions)
+    RequestCompression(RequestCompressionMethod p_method = RequestCompressionMethod::gzip, std::optional<int> p_level = std::nullopt, std::string p_dictionary = {}) : method(p_method), level(p_level), dictionary(std::move(p_dictionary)) {}
+
+    /**
+     * Returns true in case cpr has been built with the library required for the given method.
+     **/
+    [[nodiscard]] static bool IsSupported(RequestCompressionMethod method);
+    /**
+     * Returns the value of the 'Content-Encoding' header for the method.
+     **/
+    [[nodiscard]] const char* GetContentEncoding() const;
+
+    RequestCompressionMethod method;
+    std::optional<int> level;
+    std::string dictionary;
+};
+
+namespace util {
+/**
+ * Incremental compressor for a single RequestCompression method.
+ * Throws std::invalid_argument in case the method is not supported or the settings are invalid.
+ **/
+class Compressor {
+  public:
+    explicit Compressor(const RequestCompression& compression);
+    Compressor(const Compressor& other) = delete;
+    Compressor(Compressor&& old) noexcept;
+    Compressor& operator=(const Compressor& other) = delete;
+    Compressor& operator=(Compressor&& old) noexcept;
+    ~Compressor();
+
+    /**
+     * Compresses as much of input into output as fits.
+     * Consumed input gets removed from the front of input, output_size gets set to the number of bytes written to output.
+     * Once there is no more input, finish has to be set and the function called until it returns true.
+     * Throws std::runtime_error in case compressing failed.
+     **/
+    bool Compress(std::string_view& input, char* output, size_t& output_size, bool finish);
+    /**
+     * Starts a new stream, keeping the settings and the dictionary.
+     **/
+    void Reset();
+
+    /**
+     * Compresses the whole data at once.
+     **/
+    [[nodiscard]] static std::string CompressAll(const RequestCompression& compression, std::string_view data);
+
+  private:
+    struct State;
+    std::unique_ptr<State> state_;
+};
+
+/**
+ * Read source for curl compressing data pulled from another source on the fly.
+ * At most BUFFER_SIZE bytes of uncompressed data get buffered at once.
+ **/
+class CompressionStream {
+  public:
+    static constexpr size_t BUFFER_SIZE{64 * 1024};
+
+    /**
+     * read: Fills the given buffer with the next data. Sets size to the number of bytes read, 0 at the end of the data.
+     *       Returns false in case reading failed.
+     * rewind: Restarts the source at its beginning. Returns false in case this is not possible.
+     **/
+    CompressionStream(const RequestCompression& compression, std::function<bool(char* buffer, size_t& size)> read, std::function<bool()> rewind);
+
+    /**
+     * Fills the given buffer with the next compressed data.
+     * Returns the number of bytes written, 0 once all data has been sent or CURL_READFUNC_ABORT in case of an error.
+     **/
+    size_t Read(char* buffer, size_t size);
+    /**
+     * Restarts compressing the source from its beginning.
+     **/
+    bool Rewind();
+
+  private:
+    Compressor compressor_;
+    std::function<bool(char* buffer, size_t& size)> read_;
+    std::function<bool()> rewind_;
+    std::vector<char> buffer_;
+    std::string_view pending_;
+    bool finished_{false};
+    bool done_{false};
+};
+} // namespace util
+
+} // namespace cpr
+
+#endif
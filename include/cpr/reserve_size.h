@@ -12,6 +12,18 @@ class ReserveSize {
     std::size_t size = 0;
 };
 
+/**
+ * Reserves memory for the response body based on the 'Content-Length' header sent by the server before the first byte of the body arrives.
+ * To prevent a server from forcing huge allocations, at most max_size bytes get reserved.
+ * A max_size of 0 disables the automatic reservation.
+ **/
+class AutoReserveSize {
+  public:
+    AutoReserveSize(const std::size_t _max_size) : max_size(_max_size) {}
+
+    std::size_t max_size = 0;
+};
+
 } // namespace cpr
 
 #endif
@@ -4,25 +4,59 @@
 #include <cassert>
 #include <cstdint>
 #include <memory>
+#include <optional>
 #include <string>
 #include <utility>
 #include <vector>
 
+#include "cpr/buffer_pool.h"
 #include "cpr/cert_info.h"
 #include "cpr/cookies.h"
 #include "cpr/cprtypes.h"
 #include "cpr/error.h"
+#include "cpr/response_fields.h"
+#include "cpr/response_header.h"
+#include "cpr/response_sink.h"
 #include "cpr/ssl_options.h"
+#include "cpr/timings.h"
 #include "cpr/util.h"
 
 namespace cpr {
 
 class MultiPerform;
+class Session;
+
+/**
+ * Detaches responses from the curl handle of their session once the request completed (see Response::Detach(...)).
+ * Useful for retaining many responses, since otherwise each of them keeps the whole curl handle alive.
+ **/
+class DetachResponse {
+  public:
+    DetachResponse() = default;
+    DetachResponse(const bool p_detach, const bool p_cert_infos = false) : detach{p_detach}, cert_infos{p_cert_infos} {}
+
+    bool detach = true;
+    /**
+     * Copy the certificate information before detaching, so Response::GetCertInfos() keeps working.
+     **/
+    bool cert_infos = false;
+};
 
 class Response {
   private:
     friend MultiPerform;
+    friend Session;
     std::shared_ptr<CurlHolder> curl_{nullptr};
+    // Transfer of curl_ this response belongs to (see CurlHolder::generation)
+    std::uint64_t generation_{0};
+    ResponseFields loadedFields_{ResponseFields::NONE};
+    // The pool text and raw_header get returned to on destruction (see Session::SetBufferPool(...))
+    std::shared_ptr<BufferPool> bufferPool_{nullptr};
+    // Snapshot of the certificate information taken by Detach(...)
+    std::optional<std::vector<CertInfo>> certInfos_;
+
+    // Throws in case curl_ already performed another transfer
+    void checkGeneration() const;
 
   public:
     // Ignored here since libcurl uses a long for this.
@@ -32,6 +66,7 @@ class Response {
     Header header;
     Url url;
     double elapsed{};
+    Timings timings;
     Cookies cookies;
     Error error;
     std::string raw_header;
@@ -44,13 +79,49 @@ class Response {
     long redirect_count{};
     std::string primary_ip;
     std::uint16_t primary_port{};
+    /**
+     * The sink the body has been written to in case one was set via Session::SetResponseSink(...) or passed to Session::Download(...).
+     * In this case text stays empty.
+     **/
+    std::shared_ptr<ResponseSink> sink{nullptr};
 
     Response() = default;
-    Response(std::shared_ptr<CurlHolder> curl, std::string&& p_text, std::string&& p_header_string, Cookies&& p_cookies, Error&& p_error);
+    Response(std::shared_ptr<CurlHolder> curl, std::string&& p_text, std::string&& p_header_string, Cookies&& p_cookies = Cookies{}, Error&& p_error = Error{}, ResponseFields p_fields = ResponseFields::ALL);
+    /**
+     * Returns the certificate information of the connection.
+     * Returns an empty list for detached responses, except cert_infos was requested when detaching.
+     **/
     [[nodiscard]] std::vector<CertInfo> GetCertInfos() const;
+    /**
+     * Returns a read-only view of the header fields, indexing directly into raw_header without copying it.
+     * Cheaper than header in case only a few fields are of interest, e.g. when HEADER is not part of Session::SetResponseFields(...).
+     * The view stays valid as long as raw_header is neither modified nor destroyed.
+     * Moving (or move assigning) the response invalidates it as well, since a short raw_header lives inside the string object itself.
+     * Request a new view from the response at its new location instead.
+     **/
+    [[nodiscard]] ResponseHeader GetHeaderView() const;
+    /**
+     * Loads all remaining fields (see LoadFields(...)) and releases the curl handle of the session the response originates from.
+     * In case include_cert_infos is true, the certificate information gets copied so GetCertInfos() keeps working.
+     * Afterwards the response does no longer keep the handle and its connection state alive.
+     * Like LoadFields(...), this throws std::logic_error once the session performed another request.
+     **/
+    void Detach(bool include_cert_infos = false);
+    [[nodiscard]] bool IsDetached() const;
+    /**
+     * Fills the given fields in case they have not been filled yet (see Session::SetResponseFields(...)).
+     * The values are read from the curl handle of the session the response originates from.
+     * Call this before the session performs another request, since the handle then describes the new transfer.
+     * Throws std::logic_error in case fields other than ResponseFields::HEADER are requested after that.
+     **/
+    void LoadFields(ResponseFields fields);
+    /**
+     * Returns the fields filled so far.
+     **/
+    [[nodiscard]] ResponseFields GetLoadedFields() const;
     Response(const Response& other) = default;
     Response(Response&& old) noexcept = default;
-    ~Response() noexcept = default;
+    ~Response() noexcept;
 
     Response& operator=(Response&& old) noexcept = default;
     Response& operator=(const Response& other) = default;
@@ -0,0 +1,70 @@
+#ifndef CPR_RESPONSE_FIELDS_H
+#define CPR_RESPONSE_FIELDS_H
+
+#include <cstdint>
+
+namespace cpr {
+/**
+ * Selects which metadata gets filled into a Response once a request completed.
+ * Fields not selected stay default initialized and can be loaded later via Response::LoadFields(...).
+ **/
+enum class ResponseFields : uint16_t {
+    /**
+     * Response::status_code
+     **/
+    STATUS_CODE = 0x1 << 0,
+    /**
+     * Response::elapsed
+     **/
+    ELAPSED = 0x1 << 1,
+    /**
+     * Response::url
+     **/
+    URL = 0x1 << 2,
+    /**
+     * Response::uploaded_bytes and Response::downloaded_bytes
+     **/
+    TRANSFER_SIZES = 0x1 << 3,
+    /**
+     * Response::redirect_count
+     **/
+    REDIRECT_COUNT = 0x1 << 4,
+    /**
+     * Response::primary_ip
+     **/
+    PRIMARY_IP = 0x1 << 5,
+    /**
+     * Response::primary_port
+     **/
+    PRIMARY_PORT = 0x1 << 6,
+    /**
+     * Response::header, Response::status_line and Response::reason.
+     * Response::raw_header is always filled.
+     **/
+    HEADER = 0x1 << 7,
+    /**
+     * Response::timings (except for the time spent in the thread pool, which is always recorded)
+     **/
+    TIMINGS = 0x1 << 8,
+    /**
+     * Default value.
+     * Convenience option to select all fields.
+     **/
+    ALL = STATUS_CODE | ELAPSED | URL | TRANSFER_SIZES | REDIRECT_COUNT | PRIMARY_IP | PRIMARY_PORT | HEADER | TIMINGS,
+    /**
+     * Convenience option to select no fields.
+     **/
+    NONE = 0x0
+};
+
+ResponseFields operator|(ResponseFields lhs, ResponseFields rhs);
+ResponseFields operator&(ResponseFields lhs, ResponseFields rhs);
+ResponseFields operator^(ResponseFields lhs, ResponseFields rhs);
+ResponseFields operator~(ResponseFields flag);
+ResponseFields& operator|=(ResponseFields& lhs, ResponseFields rhs);
+ResponseFields& operator&=(ResponseFields& lhs, ResponseFields rhs);
+ResponseFields& operator^=(ResponseFields& lhs, ResponseFields rhs);
+bool any(ResponseFields flag);
+} // namespace cpr
+
+#endif
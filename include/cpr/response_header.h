@@ -0,0 +1,122 @@
+#ifndef CPR_RESPONSE_HEADER_H
+#define CPR_RESPONSE_HEADER_H
+
+#include <atomic>
+#include <cstddef>
+#include <iterator>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include "cpr/cprtypes.h"
+
+namespace cpr {
+
+/**
+ * Read-only view of the header fields contained in a raw header block (see Response::GetHeaderView()).
+ * Does not copy the block and only splits it into fields on first access.
+ * Fields are stored as offsets into the block, so no allocation per field is required.
+ * The block has to outlive the view and must not be modified or moved while the view is in use.
+ *
+ * Lookups are case-insensitive. In case a field is present multiple times, the last value wins.
+ * Only the fields of the last response (e.g. after following redirects) are part of the view.
+ * Use the implicit conversion to Header in case a modifiable copy is required.
+ **/
+class ResponseHeader {
+  public:
+    using value_type = std::pair<std::string_view, std::string_view>;
+
+    class const_iterator {
+      public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = ResponseHeader::value_type;
+        using difference_type = std::ptrdiff_t;
+        using pointer = const value_type*;
+        using reference = const value_type&;
+
+        const_iterator() = default;
+
+        reference operator*() const {
+            return value_;
+        }
+        pointer operator->() const {
+            return &value_;
+        }
+        const_iterator& operator++();
+        const_iterator operator++(int);
+
+        bool operator==(const const_iterator& other) const {
+            return header_ == other.header_ && index_ == other.index_;
+        }
+        bool operator!=(const const_iterator& other) const {
+            return !(*this == other);
+        }
+
+      private:
+        friend ResponseHeader;
+        const_iterator(const ResponseHeader* header, size_t index);
+
+        const ResponseHeader* header_{nullptr};
+        size_t index_{0};
+        value_type value_;
+    };
+    using iterator = const_iterator;
+
+    ResponseHeader() = default;
+    explicit ResponseHeader(std::string_view raw);
+    ResponseHeader(const ResponseHeader& other);
+    ResponseHeader(ResponseHeader&& old) noexcept;
+    ~ResponseHeader() = default;
+
+    ResponseHeader& operator=(const ResponseHeader& other);
+    ResponseHeader& operator=(ResponseHeader&& old) noexcept;
+
+    /**
+     * Returns the value of the given field or an empty view in case it is not present.
+     * The view stays valid as long as the underlying header block is neither modified nor destroyed.
+     **/
+    std::string_view operator[](std::string_view name) const;
+    /**
+     * Returns the value of the given field.
+     * Throws std::out_of_range in case the field is not present.
+     **/
+    [[nodiscard]] std::string_view at(std::string_view name) const;
+    [[nodiscard]] const_iterator find(std::string_view name) const;
+    [[nodiscard]] size_t count(std::string_view name) const;
+    [[nodiscard]] size_t size() const;
+    [[nodiscard]] bool empty() const;
+
+    [[nodiscard]] const_iterator begin() const;
+    [[nodiscard]] const_iterator end() const;
+    [[nodiscard]] const_iterator cbegin() const;
+    [[nodiscard]] const_iterator cend() const;
+
+    // NOLINTNEXTLINE (google-explicit-constructor, hicpp-explicit-conversions)
+    operator Header() const;
+
+  private:
+    struct Field {
+        // Case-insensitive hash of the name, so most mismatches get rejected without comparing the names
+        size_t name_hash;
+        size_t name_offset;
+        size_t name_length;
+        size_t value_offset;
+        size_t value_length;
+    };
+
+    const std::vector<Field>& fields() const;
+    [[nodiscard]] value_type get(size_t index) const;
+    [[nodiscard]] size_t indexOf(std::string_view name) const;
+
+    std::string_view raw_;
+    // Built on first access. Guarded by mutex_ since it gets created from const member functions.
+    mutable std::vector<Field> fields_;
+    mutable std::atomic_bool indexed_{false};
+    mutable std::mutex mutex_;
+};
+
+} // namespace cpr
+
+#endif
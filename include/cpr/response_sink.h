@@ -0,0 +1,152 @@
+#ifndef CPR_RESPONSE_SINK_H
+#define CPR_RESPONSE_SINK_H
+
+#include <cstddef>
+#include <memory_resource>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace cpr {
+
+/**
+ * Destination for the body of a response.
+ * By default the body gets appended to a std::string which then ends up inside Response::text.
+ * Setting a sink via Session::SetResponseSink(...) redirects the body into the sink instead.
+ * After the request completed, the sink used is available through Response::sink.
+ *
+ * Example:
+ * ```cpp
+ * auto sink = std::make_shared<cpr::ChunkedSink>();
+ * cpr::Response r = cpr::Get(cpr::Url{"http://xxx/large.json"}, sink);
+ * for (std::string_view chunk : sink->GetChunks()) {
+ *     ...
+ * }
+ * ```
+ **/
+class ResponseSink {
+  public:
+    ResponseSink() = default;
+    ResponseSink(const ResponseSink& other) = delete;
+    ResponseSink(ResponseSink&& old) = delete;
+    virtual ~ResponseSink() = default;
+
+    ResponseSink& operator=(const ResponseSink& other) = delete;
+    ResponseSink& operator=(ResponseSink&& old) = delete;
+
+    /**
+     * Appends the given data to the sink.
+     * Returns the number of bytes consumed. Consuming less than data.size() bytes aborts the transfer.
+     **/
+    virtual size_t Write(std::string_view data) = 0;
+
+    /**
+     * Hint about how many bytes the sink should expect.
+     * Gets called before the first Write(...) of a request in case the size is known.
+     **/
+    virtual void Reserve(size_t /*size*/) {}
+
+    /**
+     * Discards all data written so far. Gets called before each request.
+     **/
+    virtual void Clear() = 0;
+
+    /**
+     * Gets called once the request completed, so buffered data can be written out.
+     * Returns false in case this failed, which marks the request as failed with ErrorCode::WRITE_ERROR.
+     **/
+    virtual bool Flush() {
+        return true;
+    }
+
+    /**
+     * Returns the number of bytes written since the last Clear().
+     **/
+    [[nodiscard]] virtual size_t GetSize() const = 0;
+
+    /**
+     * Returns a copy of all data written since the last Clear() as a single contiguous string.
+     **/
+    [[nodiscard]] virtual std::string GetString() const = 0;
+};
+
+/**
+ * Writes the body into a caller provided buffer of fixed capacity.
+ * The buffer has to outlive the request.
+ * In case the body does not fit into the buffer, the transfer gets aborted and IsOverflown() returns true.
+ **/
+class BufferSink : public ResponseSink {
+  public:
+    BufferSink(char* data, size_t capacity) : data_(data), capacity_(capacity) {}
+
+    size_t Write(std::string_view data) override;
+    void Clear() override;
+    [[nodiscard]] size_t GetSize() const override;
+    [[nodiscard]] std::string GetString() const override;
+
+    /**
+     * Returns a view of the data written into the caller provided buffer.
+     **/
+    [[nodiscard]] std::string_view GetView() const;
+    [[nodiscard]] bool IsOverflown() const;
+
+  private:
+    char* data_;
+    size_t capacity_;
+    size_t size_{0};
+    bool overflown_{false};
+};
+
+/**
+ * Writes the body into a list of fixed size chunks.
+ * Already written data never gets moved or copied when the body grows.
+ * Chunks are kept allocated across Clear() calls, so reusing the sink for multiple requests (see Session::SetResponseSink) does not allocate again.
+ **/
+class ChunkedSink : public ResponseSink {
+  public:
+    static constexpr size_t DEFAULT_CHUNK_SIZE{64 * 1024};
+
+    explicit ChunkedSink(size_t chunk_size = DEFAULT_CHUNK_SIZE);
+
+    size_t Write(std::string_view data) override;
+    void Reserve(size_t size) override;
+    void Clear() override;
+    [[nodiscard]] size_t GetSize() const override;
+    [[nodiscard]] std::string GetString() const override;
+
+    /**
+     * Returns views of all chunks containing data in the order they have been written.
+     **/
+    [[nodiscard]] std::vector<std::string_view> GetChunks() const;
+
+  private:
+    size_t chunk_size_;
+    size_t size_{0};
+    // Number of chunks currently containing data. Chunks behind that are kept for reuse.
+    size_t used_chunks_{0};
+    std::vector<std::string> chunks_;
+};
+
+/**
+ * Writes the body into a std::pmr::string allocating from the given memory resource.
+ * The memory resource has to outlive the sink.
+ **/
+class PmrSink : public ResponseSink {
+  public:
+    explicit PmrSink(std::pmr::memory_resource* resource = std::pmr::get_default_resource()) : body_(resource) {}
+
+    size_t Write(std::string_view data) override;
+    void Reserve(size_t size) override;
+    void Clear() override;
+    [[nodiscard]] size_t GetSize() const override;
+    [[nodiscard]] std::string GetString() const override;
+
+    [[nodiscard]] const std::pmr::string& GetBody() const;
+
+  private:
+    std::pmr::string body_;
+};
+
+} // namespace cpr
+
+#endif
@@ -0,0 +1,153 @@
+#ifndef CPR_RESUMABLE_DOWNLOAD_H
+#define CPR_RESUMABLE_DOWNLOAD_H
+
+#include <cstddef>
+#include <memory>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include <curl/curl.h>
+
+#include "cpr/cprtypes.h"
+#include "cpr/file_sink.h"
+#include "cpr/response_sink.h"
+
+namespace cpr {
+
+/**
+ * State of a partially downloaded file, stored in a small sidecar file next to it.
+ * Contains the byte ranges already written to disk and the validator identifying the version of the object.
+ *
+ * The sidecar is a plain text file with one field per line:
+ * ```
+ * etag: "686897696a7c876b7e"
+ * last-modified: Wed, 21 Oct 2015 07:28:00 GMT
+ * range: 0-1048575
+ * ```
+ **/
+class DownloadCheckpoint {
+  public:
+    /**
+     * Byte ranges (first and last byte, both inclusive) completely written to disk.
+     **/
+    std::vector<std::pair<cpr_off_t, cpr_off_t>> ranges;
+    std::string etag;
+    std::string last_modified;
+
+    /**
+     * Returns the checkpoint stored at the given path or std::nullopt in case there is none or it can not be parsed.
+     **/
+    [[nodiscard]] static std::optional<DownloadCheckpoint> Load(const std::string& path);
+    /**
+     * Stores the checkpoint at the given path.
+     * The file gets replaced atomically, so a crash never leaves a partially written checkpoint behind.
+     **/
+    bool Save(const std::string& path) const;
+
+    /**
+     * Returns the number of bytes completely written from the start of the file on.
+     **/
+    [[nodiscard]] cpr_off_t GetCompletedPrefix() const;
+    /**
+     * Returns the value for the 'If-Range' header.
+     * This is the ETag in case it is a strong one, the last modification date otherwise.
+     * Empty in case the object can not be validated, which means the download can not be resumed.
+     **/
+    [[nodiscard]] std::string GetValidator() const;
+};
+
+/**
+ * Download mode for Session::Download(...) which can be continued after it failed.
+ *
+ * While downloading, a checkpoint (see DownloadCheckpoint) gets stored next to the file after every checkpoint_interval bytes
+ * and once the transfer ended. In case it did not complete, the next download into the same file continues
+ * at the end of the checkpoint using a 'Range' request. An 'If-Range' header makes sure the object did not change
+ * in the meantime. Otherwise the server sends the whole object and the download restarts from scratch.
+ * The checkpoint gets removed once the download completed.
+ *
+ * Resuming requires the server to send an 'ETag' or 'Last-Modified' header and to support range requests.
+ * A 206 response has to announce a 'Content-Range' starting at the end of the checkpoint, otherwise the transfer fails.
+ * Ranges refer to the bytes sent by the server, so the download requests the object without content encoding ('Accept-Encoding: identity')
+ * and fails in case the response has a 'Content-Encoding' anyway.
+ * A Range, 'If-Range' or 'Accept-Encoding' set on the session only gets replaced for the duration of the download.
+ *
+ * Example:
+ * ```cpp
+ * cpr::Session session;
+ * session.SetUrl(cpr::Url{"http://xxx/large.iso"});
+ * cpr::Response r = session.Download(cpr::ResumableDownload{"large.iso"});
+ * while (r.error.code == cpr::ErrorCode::PARTIAL_FILE || r.error.code == cpr::ErrorCode::RECV_ERROR) {
+ *     r = session.Download(cpr::ResumableDownload{"large.iso"});
+ * }
+ * ```
+ **/
+class ResumableDownload {
+  public:
+    static constexpr size_t DEFAULT_CHECKPOINT_INTERVAL{8 * 1024 * 1024};
+
+    explicit ResumableDownload(std::string p_filepath, size_t p_checkpoint_interval = DEFAULT_CHECKPOINT_INTERVAL) : filepath(std::move(p_filepath)), checkpoint_interval(p_checkpoint_interval) {}
+
+    /**
+     * Returns the path of the sidecar file holding the checkpoint.
+     **/
+    [[nodiscard]] std::string GetCheckpointPath() const {
+        return filepath + ".checkpoint";
+    }
+
+    std::string filepath;
+    size_t checkpoint_interval;
+};
+
+namespace util {
+/**
+ * Sink used by Session::Download(const ResumableDownload&).
+ * Writes into a FileSink and keeps the checkpoint up to date with the data written to disk.
+ **/
+class CheckpointSink : public ResponseSink {
+  public:
+    /**
+     * handle and raw_header belong to the session performing the download.
+     * They are used for checking the status and the validator of the response before writing anything.
+     **/
+    CheckpointSink(const ResumableDownload& download, DownloadCheckpoint checkpoint, CURL* handle, const std::string* raw_header);
+
+    size_t Write(std::string_view data) override;
+    void Reserve(size_t size) override;
+    void Clear() override;
+    bool Flush() override;
+    [[nodiscard]] size_t GetSize() const override;
+    [[nodiscard]] std::string GetString() const override;
+
+    /**
+     * Returns true in case the transfer got aborted since the object changed and has to be downloaded from the start.
+     **/
+    [[nodiscard]] bool IsRestartRequired() const;
+    /**
+     * Returns true in case the response did contain the object, so its data got written to the file.
+     **/
+    [[nodiscard]] bool HasWritten() const;
+
+  private:
+    bool begin();
+    bool saveCheckpoint();
+
+    DownloadCheckpoint checkpoint_;
+    cpr_off_t offset_;
+    FileSink file_;
+    std::string checkpoint_path_;
+    size_t checkpoint_interval_;
+    CURL* handle_;
+    const std::string* raw_header_;
+    size_t unsaved_{0};
+    bool started_{false};
+    bool writing_{false};
+    bool restart_required_{false};
+};
+} // namespace util
+
+} // namespace cpr
+
+#endif
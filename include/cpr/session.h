@@ -1,6 +1,7 @@
 #ifndef CPR_SESSION_H
 #define CPR_SESSION_H
 
+#include <chrono>
 #include <cstdint>
 #include <fstream>
 #include <functional>
@@ -16,11 +17,14 @@
 #include "cpr/bearer.h"
 #include "cpr/body.h"
 #include "cpr/body_view.h"
+#include "cpr/buffer_pool.h"
 #include "cpr/callback.h"
 #include "cpr/connect_timeout.h"
 #include "cpr/connection_pool.h"
+#include "cpr/cookie_jar.h"
 #include "cpr/cookies.h"
 #include "cpr/cprtypes.h"
+#include "cpr/file_body.h"
 #include "cpr/curlholder.h"
 #include "cpr/http_version.h"
 #include "cpr/interface.h"
@@ -31,13 +35,19 @@
 #include "cpr/multipart.h"
 #include "cpr/parameters.h"
 #include "cpr/payload.h"
+#include "cpr/payload_stream.h"
 #include "cpr/proxies.h"
 #include "cpr/proxyauth.h"
 #include "cpr/range.h"
 #include "cpr/redirect.h"
+#include "cpr/request_arena.h"
+#include "cpr/request_compression.h"
 #include "cpr/reserve_size.h"
 #include "cpr/resolve.h"
 #include "cpr/response.h"
+#include "cpr/response_fields.h"
+#include "cpr/response_sink.h"
+#include "cpr/resumable_download.h"
 #include "cpr/sse.h"
 #include "cpr/ssl_options.h"
 #include "cpr/timeout.h"
@@ -49,7 +59,7 @@
 namespace cpr {
 
 using AsyncResponse = AsyncWrapper<Response>;
-using Content = std::variant<std::monostate, cpr::Payload, cpr::Body, cpr::BodyView, cpr::Multipart>;
+using Content = std::variant<std::monostate, cpr::Payload, cpr::Body, cpr::BodyView, cpr::Multipart, cpr::FileBody, cpr::PayloadStream>;
 
 class Interceptor;
 class MultiPerform;
@@ -60,7 +70,7 @@ class Session : public std::enable_shared_from_this<Session> {
     Session(const Session& other) = delete;
     Session(Session&& old) = delete;
 
-    ~Session() = default;
+    ~Session();
 
     Session& operator=(Session&& old) noexcept = delete;
     Session& operator=(const Session& other) = delete;
@@ -74,7 +84,21 @@ class Session : public std::enable_shared_from_this<Session> {
     [[nodiscard]] const Header& GetHeader() const;
     void SetTimeout(const Timeout& timeout);
     void SetConnectTimeout(const ConnectTimeout& timeout);
+    /**
+     * Shares connections with all other sessions using the given pool.
+     * Throws std::invalid_argument in case a CookieJar not created from the pool has been set before.
+     **/
     void SetConnectionPool(const ConnectionPool& pool);
+    /**
+     * Recycles the body and header buffers of responses through the given pool.
+     * See BufferPool for details.
+     **/
+    void SetBufferPool(const BufferPool& pool);
+    /**
+     * Allocates the header list of each request from the given arena.
+     * See RequestArena for details.
+     **/
+    void SetRequestArena(const RequestArena& arena);
     void SetAuth(const Authentication& auth);
 // Only supported with libcurl >= 7.61.0.
 // As an alternative use SetHeader and add the token manually.
@@ -92,9 +116,33 @@ class Session : public std::enable_shared_from_this<Session> {
     void SetMultipart(const Multipart& multipart);
     void SetRedirect(const Redirect& redirect);
     void SetCookies(const Cookies& cookies);
+    void SetCookieEngine(const CookieEngine& cookie_engine);
+    /**
+     * Sends and stores cookies using the given jar instead of a cookie store of this session.
+     * Response::cookies stays empty, since listing the whole jar on each response would not scale. Use CookieJar::GetCookies() instead.
+     * A session can only use a single share, so in case a ConnectionPool has been set before, the jar has to be created from it.
+     * Throws std::invalid_argument otherwise.
+     **/
+    void SetCookieJar(const CookieJar& jar);
+    /**
+     * Selects the metadata filled into responses of this session. Default: ResponseFields::ALL
+     * Fields not selected can be loaded later via Response::LoadFields(...).
+     **/
+    void SetResponseFields(const ResponseFields& fields);
+    void SetDetachResponse(const DetachResponse& detach);
     void SetBody(Body&& body);
     void SetBody(const Body& body);
     void SetBodyView(BodyView body);
+    /**
+     * Streams the request body from the given file instead of loading it into memory.
+     * See FileBody for details.
+     **/
+    void SetFileBody(const FileBody& body);
+    /**
+     * Encodes the form body pair by pair while it gets uploaded instead of encoding it as a whole up front.
+     * See PayloadStream for details.
+     **/
+    void SetPayloadStream(const PayloadStream& payload);
     void SetLowSpeed(const LowSpeed& low_speed);
     void SetVerifySsl(const VerifySsl& verify);
     void SetUnixSocket(const UnixSocket& unix_socket);
@@ -105,6 +153,10 @@ class Session : public std::enable_shared_from_this<Session> {
     void SetProgressCallback(const ProgressCallback& progress);
     void SetDebugCallback(const DebugCallback& debug);
     void SetServerSentEventCallback(const ServerSentEventCallback& sse);
+    /**
+     * Reconnects the stream received by the ServerSentEventCallback once it ends. See ServerSentEventReconnect for details.
+     **/
+    void SetServerSentEventReconnect(const ServerSentEventReconnect& reconnect);
     void SetVerbose(const Verbose& verbose);
     void SetInterface(const Interface& iface);
     void SetLocalPort(const LocalPort& local_port);
@@ -115,9 +167,24 @@ class Session : public std::enable_shared_from_this<Session> {
     void SetResolves(const std::vector<Resolve>& resolves);
     void SetMultiRange(const MultiRange& multi_range);
     void SetReserveSize(const ReserveSize& reserve_size);
+    void SetAutoReserveSize(const AutoReserveSize& auto_reserve_size);
     void SetAcceptEncoding(const AcceptEncoding& accept_encoding);
     void SetAcceptEncoding(AcceptEncoding&& accept_encoding);
     void SetLimitRate(const LimitRate& limit_rate);
+    /**
+     * Compresses request bodies with the given method. RequestCompressionMethod::identity disables compression.
+     * Throws std::invalid_argument in case the method is not supported by this build or the settings are invalid.
+     * See RequestCompression for details.
+     **/
+    void SetRequestCompression(const RequestCompression& compression);
+    /**
+     * Writes the response body of the next request into the given sink instead of Response::text.
+     * The sink gets handed over to the resulting Response, so it is only used for a single request.
+     * Set it again to reuse it once the data of the previous Response is no longer needed, since it gets cleared before each request.
+     * Pass nullptr to restore the default behavior.
+     * Has no effect on downloads or in case a write or server-sent event callback is set.
+     **/
+    void SetResponseSink(const std::shared_ptr<ResponseSink>& sink);
 
     /**
      * Returns a reference to the content sent in previous request.
@@ -142,6 +209,8 @@ class Session : public std::enable_shared_from_this<Session> {
     void SetOption(const ConnectTimeout& timeout);
     void SetOption(const Authentication& auth);
     void SetOption(const ConnectionPool& pool);
+    void SetOption(const BufferPool& pool);
+    void SetOption(const RequestArena& arena);
 // Only supported with libcurl >= 7.61.0.
 // As an alternative use SetHeader and add the token manually.
 #if LIBCURL_VERSION_NUM >= 0x073D00
@@ -159,15 +228,22 @@ class Session : public std::enable_shared_from_this<Session> {
     void SetOption(const Multipart& multipart);
     void SetOption(const Redirect& redirect);
     void SetOption(const Cookies& cookies);
+    void SetOption(const CookieEngine& cookie_engine);
+    void SetOption(const CookieJar& jar);
+    void SetOption(const ResponseFields& fields);
+    void SetOption(const DetachResponse& detach);
     void SetOption(Body&& body);
     void SetOption(const Body& body);
     void SetOption(BodyView body);
+    void SetOption(const FileBody& body);
+    void SetOption(const PayloadStream& payload);
     void SetOption(const ReadCallback& read);
     void SetOption(const HeaderCallback& header);
     void SetOption(const WriteCallback& write);
     void SetOption(const ProgressCallback& progress);
     void SetOption(const DebugCallback& debug);
     void SetOption(const ServerSentEventCallback& sse);
+    void SetOption(const ServerSentEventReconnect& reconnect);
     void SetOption(const LowSpeed& low_speed);
     void SetOption(const VerifySsl& verify);
     void SetOption(const Verbose& verbose);
@@ -180,10 +256,13 @@ class Session : public std::enable_shared_from_this<Session> {
     void SetOption(const Range& range);
     void SetOption(const MultiRange& multi_range);
     void SetOption(const ReserveSize& reserve_size);
+    void SetOption(const AutoReserveSize& auto_reserve_size);
     void SetOption(const AcceptEncoding& accept_encoding);
     void SetOption(AcceptEncoding&& accept_encoding);
+    void SetOption(const RequestCompression& compression);
     void SetOption(const Resolve& resolve);
     void SetOption(const std::vector<Resolve>& resolves);
+    void SetOption(const std::shared_ptr<ResponseSink>& sink);
 
     cpr_off_t GetDownloadFileLength();
     /**
@@ -200,6 +279,16 @@ class Session : public std::enable_shared_from_this<Session> {
     Response Delete();
     Response Download(const WriteCallback& write);
     Response Download(std::ofstream& file);
+    /**
+     * Writes the body into the given sink, e.g. a cpr::FileSink.
+     * The sink gets cleared before the request, receives the 'Content-Length' as Reserve(...) hint
+     * and gets flushed once the request completed. It is available afterwards through Response::sink.
+     **/
+    Response Download(const std::shared_ptr<ResponseSink>& sink);
+    /**
+     * Downloads into a file in a way that can be continued after it failed. See cpr::ResumableDownload.
+     **/
+    Response Download(const ResumableDownload& download);
     Response Get();
     Response Head();
     Response Options();
@@ -211,6 +300,7 @@ class Session : public std::enable_shared_from_this<Session> {
     AsyncResponse DeleteAsync();
     AsyncResponse DownloadAsync(const WriteCallback& write);
     AsyncResponse DownloadAsync(std::ofstream& file);
+    AsyncResponse DownloadAsync(const std::shared_ptr<ResponseSink>& sink);
     AsyncResponse HeadAsync();
     AsyncResponse OptionsAsync();
     AsyncResponse PatchAsync();
@@ -244,6 +334,7 @@ class Session : public std::enable_shared_from_this<Session> {
     void PreparePut();
     void PrepareDownload(const WriteCallback& write);
     void PrepareDownload(std::ofstream& file);
+    void PrepareDownload(const std::shared_ptr<ResponseSink>& sink);
     Response Complete(CURLcode curl_error);
     Response CompleteDownload(CURLcode curl_error);
 
@@ -259,13 +350,29 @@ class Session : public std::enable_shared_from_this<Session> {
 
     bool chunkedTransferEncoding_{false};
     Content content_{std::monostate{}};
+    // Encoded form of the cpr::Payload inside content_. Reset once the payload changes.
+    std::optional<std::string> payloadContent_;
+    // Compressed form of the body or payload inside content_. Reset once either of them or the compression changes.
+    std::optional<std::string> compressedContent_;
+    std::optional<RequestCompression> requestCompression_;
+    // Compresses the cpr::FileBody, cpr::PayloadStream or the read callback body while curl reads it
+    std::unique_ptr<util::CompressionStream> compressionStream_;
+    // Read positions of the multipart parts streamed from memory. Only valid as long as curl_->multipart is.
+    std::vector<util::MimeDataReader> multipartReaders_;
+    // curl_->multipart has been built from the cpr::Multipart inside content_ and can be sent again
+    bool multipartPrepared_{false};
     std::shared_ptr<CurlHolder> curl_;
     Url url_;
     Parameters parameters_;
     Proxies proxies_;
     ProxyAuthentication proxyAuth_;
     Header header_;
+    // Set through SetRange(...) or SetMultiRange(...), restored after a Download(const ResumableDownload&)
+    std::string range_;
     AcceptEncoding acceptEncoding_;
+    // cpr decodes the response body instead of curl (see AcceptEncoding::requiresContentDecoder())
+    bool decodeContent_{false};
+    std::unique_ptr<util::ContentDecoder> contentDecoder_;
 
 
     struct Callbacks {
@@ -285,7 +392,17 @@ class Session : public std::enable_shared_from_this<Session> {
     std::unique_ptr<Callbacks> cbs_{std::make_unique<Callbacks>()};
 
     size_t response_string_reserve_size_{0};
+    size_t auto_reserve_max_size_{0};
+    util::ContentLengthReserve contentLengthReserve_;
     std::string response_string_;
+    std::shared_ptr<ResponseSink> responseSink_;
+    // Sink of the currently prepared Download(...), if any
+    std::shared_ptr<ResponseSink> downloadSink_;
+    std::shared_ptr<BufferPool> bufferPool_;
+    std::shared_ptr<RequestArena> requestArena_;
+    // Header list of the current request in case it got allocated from requestArena_. curl_->chunk stays empty then.
+    curl_slist* arenaHeader_{nullptr};
+    curl_slist* arenaHeaderTail_{nullptr};
     std::string header_string_;
     // Container type is required to keep iterator valid on elem insertion. E.g. list but not vector.
     using InterceptorsContainer = std::list<std::shared_ptr<Interceptor>>;
@@ -295,6 +412,14 @@ class Session : public std::enable_shared_from_this<Session> {
     // Interceptor within the chain where to start with each repeated request
     InterceptorsContainer::const_iterator first_interceptor_;
     bool isUsedInMultiPerform{false};
+    bool cookieEngine_{true};
+    std::optional<ServerSentEventReconnect> sseReconnect_;
+    std::optional<ConnectionPool> connectionPool_;
+    std::optional<CookieJar> cookieJar_;
+    // The curl handle currently reads from the cpr::FileBody or cpr::PayloadStream inside content_
+    bool bodyStreamPrepared_{false};
+    ResponseFields responseFields_{ResponseFields::ALL};
+    DetachResponse detachResponse_{false};
     bool isCancellable{false};
 
 #if SUPPORT_SSL_NO_REVOKE
@@ -317,14 +442,47 @@ class Session : public std::enable_shared_from_this<Session> {
      * Prepares the curl object for a request with everything used by the download request.
      **/
     void prepareCommonDownload();
+    /**
+     * Decodes the response body with a util::ContentDecoder passing the decoded data on to the given write function.
+     **/
+    void prepareContentDecoder(std::function<size_t(char* data, size_t size)> write);
     void prepareHeader();
+    // Adds a line to the headers prepared by prepareHeader()
+    void appendHeader(const char* line);
+    // Adds a line allocated from requestArena_ to the headers prepared by prepareHeader()
+    void appendArenaHeader(char* line);
+    // Passes the headers prepared so far to curl. Called once all lines got appended.
+    void applyHeader();
     void prepareProxy();
     CURLcode DoEasyPerform();
-    void prepareBodyPayloadOrMultipart() const;
     /**
-     * Returns true in case content_ is of type cpr::Body or cpr::Payload.
+     * Sends the request again as long as the Server-Sent Event stream should be reconnected.
+     * Takes and returns the result of the last attempt.
+     **/
+    CURLcode reconnectServerSentEvents(CURLcode curl_error);
+    /**
+     * Waits before reconnecting. Returns false in case the request got cancelled or the progress callback returned false meanwhile.
+     **/
+    bool waitForReconnect(std::chrono::milliseconds delay);
+    void prepareBodyPayloadOrMultipart();
+    /**
+     * Sends the body compressed in case a RequestCompression is set and the body can be compressed.
+     * Returns false in case the body has to be sent uncompressed.
+     **/
+    bool prepareCompressedBody();
+    /**
+     * Restores the read callback replaced for streaming a cpr::FileBody, a cpr::PayloadStream or a compressed body.
+     **/
+    void resetBodyStream();
+    /**
+     * Returns true in case content_ is of type cpr::Body, cpr::BodyView, cpr::FileBody, cpr::Payload or cpr::PayloadStream.
      **/
     [[nodiscard]] bool hasBodyOrPayload() const;
+    /**
+     * Returns the cookies known by the cookie engine after a request.
+     * Empty in case the cookie engine is disabled or a CookieJar is used.
+     **/
+    Cookies getResponseCookies();
 };
 
 template <typename Then>
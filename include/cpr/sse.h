@@ -1,6 +1,8 @@
 #ifndef CPR_SSE_H
 #define CPR_SSE_H
 
+#include <chrono>
+#include <cstddef>
 #include <cstdint>
 #include <functional>
 #include <optional>
@@ -59,11 +61,32 @@ class ServerSentEventParser {
      */
     void reset();
 
+    /**
+     * Drop the incomplete line and event, e.g. after the connection got lost.
+     * In contrast to reset(), the last event ID and the reconnection time are kept.
+     */
+    void discardEvent();
+
+    /**
+     * The ID of the last event dispatched, to be sent as 'Last-Event-ID' when reconnecting.
+     * std::nullopt in case the stream did not set one yet, empty in case it cleared it using an empty 'id' field.
+     */
+    [[nodiscard]] const std::optional<std::string>& lastEventId() const;
+
+    /**
+     * The reconnection time in milliseconds requested by the stream via the 'retry' field.
+     */
+    [[nodiscard]] std::optional<size_t> retry() const;
+
   private:
+    // Incomplete last line of the previous chunk, or all of its rest in case a callback aborted parsing
     std::string buffer_;
+    bool aborted_{false};
     ServerSentEvent current_event_;
+    std::optional<std::string> last_event_id_;
+    std::optional<size_t> retry_;
 
-    bool processLine(const std::string& line, const std::function<bool(ServerSentEvent&&)>& callback);
+    bool processLine(std::string_view line, const std::function<bool(ServerSentEvent&&)>& callback);
     bool dispatchEvent(const std::function<bool(ServerSentEvent&&)>& callback);
 };
 
@@ -89,6 +112,13 @@ class ServerSentEventCallback {
      */
     bool handleData(std::string_view data);
 
+    /**
+     * Internal functions used for reconnecting, see ServerSentEventParser.
+     */
+    void discardEvent();
+    [[nodiscard]] const std::optional<std::string>& lastEventId() const;
+    [[nodiscard]] std::optional<size_t> retry() const;
+
     intptr_t userdata{};
     std::function<bool(ServerSentEvent&& event, intptr_t userdata)> callback;
 
@@ -96,6 +126,55 @@ class ServerSentEventCallback {
     ServerSentEventParser parser_;
 };
 
+/**
+ * Reconnects Server-Sent Event streams (see Session::SetServerSentEventCallback(...)) once the connection ends,
+ * like an EventSource in a browser does.
+ *
+ * After the stream ended or the connection got lost, the request gets sent again with a 'Last-Event-ID' header
+ * carrying the ID of the last event received, so the server can continue where the stream stopped. In case the stream cleared the ID
+ * using an empty 'id' field, no 'Last-Event-ID' gets sent anymore.
+ * The same callback keeps receiving the events. Incomplete events of the lost connection get dropped.
+ * The connection gets reused in case it is still alive, otherwise a new one gets created (or taken from a ConnectionPool).
+ *
+ * Before reconnecting, the session waits for the reconnection time sent by the server via the 'retry' field, or `retry` otherwise,
+ * both limited to `max_retry`. The delay doubles with each attempt in a row that does not get a stream from the server, up to `max_retry`,
+ * and up to half of it gets added at random (still limited to `max_retry`), so clients do not all reconnect at once.
+ * Cancelling the request (or returning false from the ProgressCallback) also ends the wait.
+ *
+ * Reconnecting stops once the callback returns false, the request got cancelled, the server responds with a status code other than 200
+ * (e.g. 204 No Content to end the stream), or after `max_attempts` attempts in a row failed.
+ * The response returned is the one of the last attempt.
+ *
+ * Not supported with MultiPerform.
+ *
+ * Example:
+ * ```cpp
+ * cpr::Session session;
+ * session.SetUrl(cpr::Url{"http://example.com/events"});
+ * session.SetServerSentEventCallback(cpr::ServerSentEventCallback{[](cpr::ServerSentEvent&& event, intptr_t) { return Handle(event); }});
+ * session.SetServerSentEventReconnect(cpr::ServerSentEventReconnect{});
+ * cpr::Response r = session.Get();
+ * ```
+ */
+class ServerSentEventReconnect {
+  public:
+    ServerSentEventReconnect() = default;
+    ServerSentEventReconnect(size_t p_max_attempts, std::chrono::milliseconds p_retry = std::chrono::milliseconds{3000}, std::chrono::milliseconds p_max_retry = std::chrono::milliseconds{30000}) : max_attempts{p_max_attempts}, retry{p_retry}, max_retry{p_max_retry} {}
+
+    /**
+     * Maximum number of attempts in a row not getting a stream from the server. 0 disables reconnecting.
+     */
+    size_t max_attempts{10};
+    /**
+     * Reconnection time used until the server sends one.
+     */
+    std::chrono::milliseconds retry{3000};
+    /**
+     * Upper bound for the reconnection time, including the one sent by the server and the backoff.
+     */
+    std::chrono::milliseconds max_retry{30000};
+};
+
 } // namespace cpr
 
 #endif
@@ -12,6 +12,8 @@
 #include <mutex>
 #include <queue>
 #include <thread>
+#include <tuple>
+#include <type_traits>
 #include <utility>
 
 #define CPR_DEFAULT_THREAD_POOL_MAX_THREAD_NUM std::thread::hardware_concurrency()
@@ -21,6 +23,20 @@ constexpr std::chrono::milliseconds CPR_DEFAULT_THREAD_POOL_MAX_IDLE_TIME{250};
 
 namespace cpr {
 
+/**
+ * Whether a task submitted as fn(args...) gets its stored (decay-copied) arguments passed as rvalues.
+ * Like std::async, they get moved into fn to avoid further copies.
+ * Like std::bind, they get passed as lvalues instead if fn only accepts lvalue references (e.g. void fn(int&)).
+ **/
+template <class Fn, class... Args>
+inline constexpr bool task_takes_rvalues_v = std::is_invocable_v<std::decay_t<Fn>&, std::decay_t<Args>&&...>;
+
+/**
+ * Result type of a task submitted as fn(args...).
+ **/
+template <class Fn, class... Args>
+using task_result_t = typename std::conditional_t<task_takes_rvalues_v<Fn, Args...>, std::invoke_result<std::decay_t<Fn>&, std::decay_t<Args>&&...>, std::invoke_result<std::decay_t<Fn>&, std::decay_t<Args>&...>>::type;
+
 class ThreadPool {
   public:
     using Task = std::function<void()>;
@@ -82,8 +98,15 @@ class ThreadPool {
         if (idle_thread_num <= 0 && cur_thread_num < max_thread_num) {
             CreateThread();
         }
-        using RetType = decltype(fn(args...));
-        auto task = std::make_shared<std::packaged_task<RetType()>>([fn = std::forward<Fn>(fn), args...]() mutable { return std::invoke(fn, args...); });
+        // fn and args get decay-copied (or moved) once, see task_takes_rvalues_v for how the arguments are passed on
+        using RetType = task_result_t<Fn, Args...>;
+        auto task = std::make_shared<std::packaged_task<RetType()>>([fn = std::forward<Fn>(fn), args = std::tuple<std::decay_t<Args>...>(std::forward<Args>(args)...)]() mutable {
+            if constexpr (task_takes_rvalues_v<Fn, Args...>) {
+                return std::apply(fn, std::move(args));
+            } else {
+                return std::apply(fn, args);
+            }
+        });
         std::future<RetType> future = task->get_future();
         {
             std::scoped_lock const locker(task_mutex);
@@ -0,0 +1,54 @@
+#ifndef CPR_TIMINGS_H
+#define CPR_TIMINGS_H
+
+#include <chrono>
+
+namespace cpr {
+
+/**
+ * Breakdown of the time spent on the phases of a request.
+ * Except for queue, all values are measured from the start of the transfer until the respective phase completed.
+ * Filled from the CURLINFO_*_TIME_T counters, so they stay zero with libcurl < 7.61.0.
+ * https://curl.se/libcurl/c/curl_easy_getinfo.html#TIMES
+ **/
+class Timings {
+  public:
+    /**
+     * Time spent waiting before the transfer started.
+     * Includes the time waiting for a thread of the thread pool for async requests
+     * and the time queued inside the multi handle for libcurl >= 8.6.0 (CURLINFO_QUEUE_TIME_T).
+     **/
+    std::chrono::microseconds queue{0};
+    /**
+     * Until the name resolving completed (CURLINFO_NAMELOOKUP_TIME_T).
+     **/
+    std::chrono::microseconds name_lookup{0};
+    /**
+     * Until the connection to the remote host (or proxy) was established (CURLINFO_CONNECT_TIME_T).
+     **/
+    std::chrono::microseconds connect{0};
+    /**
+     * Until the SSL/TLS handshake completed (CURLINFO_APPCONNECT_TIME_T). Zero for plain HTTP.
+     **/
+    std::chrono::microseconds app_connect{0};
+    /**
+     * Until the request is about to be sent (CURLINFO_PRETRANSFER_TIME_T).
+     **/
+    std::chrono::microseconds pre_transfer{0};
+    /**
+     * Until the first byte of the response was received (CURLINFO_STARTTRANSFER_TIME_T).
+     **/
+    std::chrono::microseconds start_transfer{0};
+    /**
+     * Spent on all redirection steps before the final transaction started (CURLINFO_REDIRECT_TIME_T).
+     **/
+    std::chrono::microseconds redirect{0};
+    /**
+     * The whole transfer including all redirects (CURLINFO_TOTAL_TIME_T).
+     **/
+    std::chrono::microseconds total{0};
+};
+
+} // namespace cpr
+
+#endif
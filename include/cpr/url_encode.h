@@ -0,0 +1,49 @@
+#ifndef CPR_URL_ENCODE_H
+#define CPR_URL_ENCODE_H
+
+#include <cstddef>
+#include <string>
+#include <string_view>
+
+#include "cpr/secure_string.h"
+
+namespace cpr::util {
+
+/**
+ * URL encoding (percent encoding) without a curl handle.
+ * Produces the same results as curl_easy_escape(...) and curl_easy_unescape(...):
+ * All characters except 'A-Z', 'a-z', '0-9', '-', '.', '_' and '~' get encoded as '%XX' using upper case hex digits.
+ * Decoding replaces every '%' followed by two hex digits, anything else (including '+') gets kept as it is.
+ *
+ * The functions writing into a caller provided buffer do not allocate.
+ * Use the secure variants for secrets only, since the memory of a SecureString gets cleared on release.
+ **/
+
+/**
+ * Returns the size of the given string once URL encoded.
+ **/
+[[nodiscard]] size_t urlEncodedSize(std::string_view s);
+/**
+ * URL encodes the given string into output, which has to hold at least urlEncodedSize(s) bytes.
+ * Returns the number of bytes written.
+ **/
+size_t urlEncode(std::string_view s, char* output);
+/**
+ * URL decodes the given string into output, which has to hold at least s.size() bytes.
+ * Returns the number of bytes written.
+ **/
+size_t urlDecode(std::string_view s, char* output);
+
+/**
+ * Appends the URL encoded string to output.
+ **/
+void appendUrlEncoded(std::string& output, std::string_view s);
+
+[[nodiscard]] std::string urlEncode(std::string_view s);
+[[nodiscard]] std::string urlDecode(std::string_view s);
+[[nodiscard]] util::SecureString urlEncodeSecure(std::string_view s);
+[[nodiscard]] util::SecureString urlDecodeSecure(std::string_view s);
+
+} // namespace cpr::util
+
+#endif
@@ -3,25 +3,66 @@
 
 #include <fstream>
 #include <memory>
+#include <optional>
 #include <string>
+#include <string_view>
+#include <utility>
 #include <vector>
 
 #include "cpr/callback.h"
+#include "cpr/content_decoder.h"
 #include "cpr/cookies.h"
 #include "cpr/cprtypes.h"
+#include "cpr/file_body.h"
+#include "cpr/payload_stream.h"
+#include "cpr/request_compression.h"
+#include "cpr/response_sink.h"
 #include "cpr/secure_string.h"
 #include "cpr/sse.h"
+#include "cpr/url_encode.h"
 
 namespace cpr::util {
 
+/**
+ * Data passed to writeHeaderReserveFunction(...).
+ * Either body or sink is set.
+ **/
+struct ContentLengthReserve {
+    std::string* header{nullptr};
+    std::string* body{nullptr};
+    ResponseSink* sink{nullptr};
+    size_t max_size{0};
+};
+
+/**
+ * Data passed to readMimeDataFunction(...) for streaming a multipart part from memory owned by someone else.
+ **/
+struct MimeDataReader {
+    const char* data{nullptr};
+    size_t size{0};
+    size_t offset{0};
+};
+
 Header parseHeader(const std::string& headers, std::string* status_line = nullptr, std::string* reason = nullptr);
 Cookies parseCookies(curl_slist* raw_cookies);
 size_t readUserFunction(char* ptr, size_t size, size_t nitems, const ReadCallback* read);
+size_t readFileBodyFunction(char* ptr, size_t size, size_t nitems, const FileBody* body);
+int seekFileBodyFunction(const FileBody* body, cpr_off_t offset, int origin);
+size_t readPayloadStreamFunction(char* ptr, size_t size, size_t nitems, PayloadStream* payload);
+int seekPayloadStreamFunction(PayloadStream* payload, cpr_off_t offset, int origin);
+size_t readCompressedFunction(char* ptr, size_t size, size_t nitems, CompressionStream* stream);
+int seekCompressedFunction(CompressionStream* stream, cpr_off_t offset, int origin);
+// Take a void pointer since they get passed to curl_mime_data_cb(...) instead of curl_easy_setopt(...)
+size_t readMimeDataFunction(char* ptr, size_t size, size_t nitems, void* reader);
+int seekMimeDataFunction(void* reader, cpr_off_t offset, int origin);
 size_t headerUserFunction(char* ptr, size_t size, size_t nmemb, const HeaderCallback* header);
 size_t writeFunction(char* ptr, size_t size, size_t nmemb, void* data);
+size_t writeHeaderReserveFunction(char* ptr, size_t size, size_t nmemb, ContentLengthReserve* data);
+size_t writeSinkFunction(char* ptr, size_t size, size_t nmemb, ResponseSink* sink);
 size_t writeFileFunction(char* ptr, size_t size, size_t nmemb, std::ofstream* file);
 size_t writeUserFunction(char* ptr, size_t size, size_t nmemb, const WriteCallback* write);
 size_t writeSSEFunction(char* ptr, size_t size, size_t nmemb, ServerSentEventCallback* sse);
+size_t writeDecoderFunction(char* ptr, size_t size, size_t nmemb, ContentDecoder* decoder);
 
 template <typename T = ProgressCallback>
 int progressUserFunction(const T* progress, cpr_pf_arg_t dltotal, cpr_pf_arg_t dlnow, cpr_pf_arg_t ultotal, cpr_pf_arg_t ulnow) {
@@ -32,9 +73,13 @@ int progressUserFunction(const T* progress, cpr_pf_arg_t dltotal, cpr_pf_arg_t d
     return (*progress)(dltotal, dlnow, ultotal, ulnow) ? 0 : cancel_retval;
 }
 int debugUserFunction(CURL* handle, curl_infotype type, char* data, size_t size, const DebugCallback* debug);
+std::optional<size_t> parseContentLength(std::string_view header_line);
+/**
+ * Returns the first and last byte position of a 'Content-Range: bytes <first>-<last>/<length>' header line.
+ * Returns std::nullopt for other lines and for the form without positions sent along with a 416 status.
+ **/
+std::optional<std::pair<cpr_off_t, cpr_off_t>> parseContentRange(std::string_view header_line);
 std::vector<std::string> split(const std::string& to_split, char delimiter);
-util::SecureString urlEncode(std::string_view s);
-util::SecureString urlDecode(std::string_view s);
 
 bool isTrue(const std::string& s);
 
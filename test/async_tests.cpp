@@ -1,6 +1,8 @@
 #include <gtest/gtest.h>
 
 #include <string>
+#include <utility>
+#include <variant>
 #include <vector>
 
 #include "cpr/cpr.h"
@@ -67,6 +69,48 @@ TEST(AsyncTests, AsyncGetMultipleReflectTest) {
     }
 }
 
+TEST(AsyncTests, AsyncBodyNotCopiedTest) {
+    Url url{server->GetBaseUrl() + "/hello.html"};
+    Body body{std::string(10 * 1024 * 1024, 'x')};
+    const char* data = body.data();
+    // The body has to be moved all the way into the session (the same way *Async(...) passes its options), so it keeps its buffer
+    auto future = cpr::async(
+            [data](auto&&... ts) {
+                Session session;
+                priv::set_option(session, std::forward<decltype(ts)>(ts)...);
+                return std::get<Body>(session.GetContent()).data() == data;
+            },
+            url, std::move(body));
+    EXPECT_TRUE(future.get());
+}
+
+TEST(AsyncTests, AsyncBodyLvalueCopiedTest) {
+    Url url{server->GetBaseUrl() + "/hello.html"};
+    const Body body{std::string(10 * 1024 * 1024, 'x')};
+    auto future = cpr::async(
+            [data = body.data()](auto&&... ts) {
+                Session session;
+                priv::set_option(session, std::forward<decltype(ts)>(ts)...);
+                return std::get<Body>(session.GetContent()).data() != data;
+            },
+            url, body);
+    EXPECT_TRUE(future.get());
+    EXPECT_EQ(10 * 1024 * 1024, body.str().size());
+}
+
+TEST(AsyncTests, AsyncLvalueReferenceArgumentTest) {
+    // Functions taking lvalue references get the stored copy of the argument, like with std::bind
+    int value{1};
+    auto future = cpr::async(
+            [](int& inner) {
+                inner++;
+                return inner;
+            },
+            value);
+    EXPECT_EQ(2, future.get());
+    EXPECT_EQ(1, value);
+}
+
 TEST(AsyncTests, AsyncDownloadTest) {
     cpr::Url url{server->GetBaseUrl() + "/download_gzip.html"};
     cpr::AsyncResponse future = cpr::DownloadAsync(fs::path{"/tmp/aync_download"}, url, cpr::Header{{"Accept-Encoding", "gzip"}}, cpr::WriteCallback{write_data, 0});
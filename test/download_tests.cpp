@@ -1,6 +1,9 @@
 #include <cstddef>
 #include <gtest/gtest.h>
 
+#include <cstdio>
+#include <fstream>
+#include <memory>
 #include <string>
 
 #include "cpr/accept_encoding.h"
@@ -9,6 +12,9 @@
 #include "cpr/api.h"
 #include "cpr/callback.h"
 #include "cpr/cprtypes.h"
+#include "cpr/file_sink.h"
+#include "cpr/parallel_download.h"
+#include "cpr/resumable_download.h"
 #include "cpr/session.h"
 #include "httpServer.hpp"
 
@@ -145,6 +151,180 @@ TEST(DownloadTests, GetDownloadFileLength) {
     EXPECT_EQ(strFileData, "this is a file content.");
 }
 
+TEST(DownloadTests, DownloadFileSink) {
+    cpr::Url url{server->GetBaseUrl() + "/get_download_file_length.html"};
+    cpr::Session session;
+    session.SetUrl(url);
+    auto sink = std::make_shared<cpr::FileSink>("download_file_sink");
+    cpr::Response response = session.Download(sink);
+    EXPECT_EQ(url, response.url);
+    EXPECT_EQ(200, response.status_code);
+    EXPECT_EQ(cpr::ErrorCode::OK, response.error.code);
+    EXPECT_EQ(response.sink, sink);
+    EXPECT_EQ(sink->GetString(), "this is a file content.");
+
+    // The sink gets cleared before each download
+    response = session.Download(sink);
+    EXPECT_EQ(cpr::ErrorCode::OK, response.error.code);
+    EXPECT_EQ(sink->GetString(), "this is a file content.");
+    std::remove(sink->GetPath().c_str());
+}
+
+TEST(DownloadTests, ParallelDownload) {
+    cpr::Url url{server->GetBaseUrl() + "/range_download.html"};
+    const std::string filename{"download_parallel"};
+    cpr::Response response = cpr::ParallelDownload(url, filename, 4, cpr::ConnectionPool{});
+    EXPECT_EQ(200, response.status_code);
+    EXPECT_EQ(cpr::ErrorCode::OK, response.error.code);
+    EXPECT_EQ(54, response.downloaded_bytes);
+    ASSERT_TRUE(response.sink);
+    EXPECT_EQ(response.sink->GetString(), "This file gets downloaded in multiple parallel ranges.");
+    std::remove(filename.c_str());
+}
+
+TEST(DownloadTests, ParallelDownloadWithoutRanges) {
+    // HEAD is not allowed, so it falls back to a single download
+    cpr::Url url{server->GetBaseUrl() + "/get_download_file_length.html"};
+    const std::string filename{"download_parallel_fallback"};
+    cpr::Response response = cpr::ParallelDownload(url, filename, 4, cpr::ConnectionPool{});
+    EXPECT_EQ(200, response.status_code);
+    EXPECT_EQ(cpr::ErrorCode::OK, response.error.code);
+    ASSERT_TRUE(response.sink);
+    EXPECT_EQ(response.sink->GetString(), "this is a file content.");
+    std::remove(filename.c_str());
+}
+
+TEST(DownloadTests, ParallelDownloadEncodedResource) {
+    // Ranges have to be requested without content encoding, even if the caller accepts gzip
+    cpr::Url url{server->GetBaseUrl() + "/range_download_gzip.html"};
+    const std::string filename{"download_parallel_encoded"};
+    cpr::Response response = cpr::ParallelDownload(url, filename, 4, cpr::ConnectionPool{}, cpr::Header{{"Accept-Encoding", "gzip"}});
+    EXPECT_EQ(200, response.status_code);
+    EXPECT_EQ(cpr::ErrorCode::OK, response.error.code);
+    ASSERT_TRUE(response.sink);
+    EXPECT_EQ(response.sink->GetString(), "This file gets downloaded in multiple parallel ranges.");
+    std::remove(filename.c_str());
+}
+
+TEST(DownloadTests, ParallelDownloadAlwaysEncodedResource) {
+    // The server ignores the requested encoding, so it falls back to a single (decoded) download
+    cpr::Url url{server->GetBaseUrl() + "/range_download_gzip_only.html"};
+    const std::string filename{"download_parallel_always_encoded"};
+    cpr::Response response = cpr::ParallelDownload(url, filename, 4, cpr::ConnectionPool{});
+    EXPECT_EQ(200, response.status_code);
+    EXPECT_EQ(cpr::ErrorCode::OK, response.error.code);
+    ASSERT_TRUE(response.sink);
+    EXPECT_EQ(response.sink->GetString(), "This file gets downloaded in multiple parallel ranges.");
+    std::remove(filename.c_str());
+}
+
+TEST(DownloadTests, ResumableDownloadResume) {
+    cpr::Url url{server->GetBaseUrl() + "/range_download.html"};
+    const cpr::ResumableDownload download{"download_resumable"};
+    // Simulate a download that failed after the first 10 bytes
+    std::ofstream{download.filepath} << "This file ---";
+    cpr::DownloadCheckpoint checkpoint;
+    checkpoint.etag = "\"cpr-range-download\"";
+    checkpoint.ranges.emplace_back(0, 9);
+    ASSERT_TRUE(checkpoint.Save(download.GetCheckpointPath()));
+
+    cpr::Session session;
+    session.SetUrl(url);
+    cpr::Response response = session.Download(download);
+    EXPECT_EQ(206, response.status_code);
+    EXPECT_EQ(cpr::ErrorCode::OK, response.error.code);
+    EXPECT_EQ(44, response.downloaded_bytes);
+    EXPECT_EQ(response.sink->GetString(), "This file gets downloaded in multiple parallel ranges.");
+    EXPECT_FALSE(cpr::DownloadCheckpoint::Load(download.GetCheckpointPath()));
+    std::remove(download.filepath.c_str());
+}
+
+TEST(DownloadTests, ResumableDownloadChanged) {
+    cpr::Url url{server->GetBaseUrl() + "/range_download.html"};
+    const cpr::ResumableDownload download{"download_resumable_changed"};
+    std::ofstream{download.filepath} << "Outdated content";
+    cpr::DownloadCheckpoint checkpoint;
+    checkpoint.etag = "\"outdated\"";
+    checkpoint.ranges.emplace_back(0, 15);
+    ASSERT_TRUE(checkpoint.Save(download.GetCheckpointPath()));
+
+    // The validator does not match anymore, so the download starts from scratch
+    cpr::Session session;
+    session.SetUrl(url);
+    cpr::Response response = session.Download(download);
+    EXPECT_EQ(200, response.status_code);
+    EXPECT_EQ(cpr::ErrorCode::OK, response.error.code);
+    EXPECT_EQ(response.sink->GetString(), "This file gets downloaded in multiple parallel ranges.");
+    EXPECT_FALSE(cpr::DownloadCheckpoint::Load(download.GetCheckpointPath()));
+    std::remove(download.filepath.c_str());
+}
+
+TEST(DownloadTests, ResumableDownloadEncodedResource) {
+    // The server would send a range of the gzip compressed file in case the request accepted it
+    cpr::Url url{server->GetBaseUrl() + "/range_download_gzip.html"};
+    const cpr::ResumableDownload download{"download_resumable_gzip"};
+    std::ofstream{download.filepath} << "This file ---";
+    cpr::DownloadCheckpoint checkpoint;
+    checkpoint.etag = "\"cpr-range-download\"";
+    checkpoint.ranges.emplace_back(0, 9);
+    ASSERT_TRUE(checkpoint.Save(download.GetCheckpointPath()));
+
+    cpr::Session session;
+    session.SetUrl(url);
+    session.SetHeader(cpr::Header{{"Accept-Encoding", "gzip"}});
+    cpr::Response response = session.Download(download);
+    EXPECT_EQ(206, response.status_code);
+    EXPECT_EQ(cpr::ErrorCode::OK, response.error.code);
+    EXPECT_EQ(response.sink->GetString(), "This file gets downloaded in multiple parallel ranges.");
+    EXPECT_EQ(session.GetHeader()["Accept-Encoding"], "gzip");
+    std::remove(download.filepath.c_str());
+}
+
+TEST(DownloadTests, ResumableDownloadRejectsContentEncoding) {
+    cpr::Url url{server->GetBaseUrl() + "/range_download_gzip_only.html"};
+    const cpr::ResumableDownload download{"download_resumable_gzip_only"};
+    std::ofstream{download.filepath} << "This file ---";
+    cpr::DownloadCheckpoint checkpoint;
+    checkpoint.etag = "\"cpr-range-download\"";
+    checkpoint.ranges.emplace_back(0, 9);
+    ASSERT_TRUE(checkpoint.Save(download.GetCheckpointPath()));
+
+    // Offsets of the compressed data do not fit the decoded file, so nothing gets written
+    cpr::Session session;
+    session.SetUrl(url);
+    cpr::Response response = session.Download(download);
+    EXPECT_EQ(cpr::ErrorCode::WRITE_ERROR, response.error.code);
+    EXPECT_EQ(response.sink->GetString(), "This file ");
+    EXPECT_TRUE(cpr::DownloadCheckpoint::Load(download.GetCheckpointPath()));
+    std::remove(download.filepath.c_str());
+    std::remove(download.GetCheckpointPath().c_str());
+}
+
+TEST(DownloadTests, ResumableDownloadRestoresRangeOptions) {
+    cpr::Url url{server->GetBaseUrl() + "/range_download.html"};
+    const cpr::ResumableDownload download{"download_resumable_restore"};
+    std::ofstream{download.filepath} << "This file ---";
+    cpr::DownloadCheckpoint checkpoint;
+    checkpoint.etag = "\"cpr-range-download\"";
+    checkpoint.ranges.emplace_back(0, 9);
+    ASSERT_TRUE(checkpoint.Save(download.GetCheckpointPath()));
+
+    cpr::Session session;
+    session.SetUrl(url);
+    session.SetHeader(cpr::Header{{"If-Range", "\"own-validator\""}});
+    session.SetRange(cpr::Range{0, 3});
+    cpr::Response response = session.Download(download);
+    EXPECT_EQ(206, response.status_code);
+    EXPECT_EQ(response.sink->GetString(), "This file gets downloaded in multiple parallel ranges.");
+    std::remove(download.filepath.c_str());
+
+    // The options set by the caller apply again to the following requests
+    session.SetUrl(cpr::Url{server->GetBaseUrl() + "/header_reflect.html"});
+    response = session.Get();
+    EXPECT_EQ(std::string{"\"own-validator\""}, response.header["If-Range"]);
+    EXPECT_EQ(std::string{"bytes=0-3"}, response.header["Range"]);
+}
+
 int main(int argc, char** argv) {
     ::testing::InitGoogleTest(&argc, argv);
     ::testing::AddGlobalTestEnvironment(server);
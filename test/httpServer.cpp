@@ -1,4 +1,5 @@
 #include "httpServer.hpp"
+#include <algorithm>
 #include <array>
 #include <chrono>
 #include <ctime>
@@ -882,6 +883,69 @@ void HttpServer::OnRequestGetDownloadFileLength(mg_connection* conn, mg_http_mes
     }
 }
 
+void HttpServer::OnRequestRangeDownload(mg_connection* conn, mg_http_message* msg) {
+    const std::string uri{msg->uri.ptr, msg->uri.len};
+    const std::string plain{"This file gets downloaded in multiple parallel ranges."};
+    // The content above compressed using gzip, served as it is like 'gzip_static' of nginx does
+    const std::string gzip{"\x1f\x8b\x08\x00\x00\x00\x00\x00\x02\x03\x0b\xc9\xc8\x2c\x56\x48\xcb\xcc\x49\x55\x48\x4f\x2d\x29\x56\x48\xc9\x2f\xcf\xcb\xc9\x4f\x4c\x49\x4d\x51\xc8\xcc\x53\xc8\x2d\xcd\x29\xc9\x2c\x00\xca\x15\x24\x16\x25\xe6\xe4\xa4\xe6\x28\x14\x25\xe6\xa5\xa7\x16\xeb\x01\x00\x9b\x2c\x35\x0f\x36\x00\x00\x00", 73};
+    mg_str* accept_encoding = mg_http_get_header(msg, "Accept-Encoding");
+    const bool accepts_gzip = accept_encoding != nullptr && std::string{accept_encoding->ptr, accept_encoding->len}.find("gzip") != std::string::npos;
+    // '/range_download_gzip.html' sends gzip whenever it is accepted, '/range_download_gzip_only.html' always
+    const bool use_gzip = uri == "/range_download_gzip_only.html" || (uri == "/range_download_gzip.html" && accepts_gzip);
+    const std::string& content = use_gzip ? gzip : plain;
+    const std::string encoding = use_gzip ? "Content-Encoding: gzip\r\n" : "";
+    const std::string etag{"\"cpr-range-download\""};
+    auto method = std::string{msg->method.ptr, msg->method.len};
+    if (method == std::string{"HEAD"}) {
+        mg_printf(conn, "HTTP/1.1 200 OK\r\nAccept-Ranges: bytes\r\nETag: %s\r\n%sContent-Length: %d\r\n\r\n", etag.c_str(), encoding.c_str(), static_cast<int>(content.length()));
+        return;
+    }
+
+    mg_str* range = mg_http_get_header(msg, "Range");
+    mg_str* if_range = mg_http_get_header(msg, "If-Range");
+    // A range is only sent in case the object did not change (RFC 9110, section 13.1.5)
+    if (range == nullptr || (if_range != nullptr && std::string{if_range->ptr, if_range->len} != etag)) {
+        mg_printf(conn, "HTTP/1.1 200 OK\r\nETag: %s\r\n%sContent-Length: %d\r\n\r\n", etag.c_str(), encoding.c_str(), static_cast<int>(content.length()));
+        mg_send(conn, content.data(), content.length());
+        return;
+    }
+    // Only single ranges of the form 'bytes=first-last' or 'bytes=first-' get requested
+    const std::string value{range->ptr, range->len};
+    const std::string last_str = value.substr(value.find('-') + 1);
+    const size_t first = std::stoul(value.substr(value.find('=') + 1));
+    const size_t last = last_str.empty() ? content.length() - 1 : std::min<size_t>(std::stoul(last_str), content.length() - 1);
+    const std::string part = content.substr(first, last - first + 1);
+    mg_printf(conn, "HTTP/1.1 206 Partial Content\r\nETag: %s\r\n%sContent-Range: bytes %d-%d/%d\r\nContent-Length: %d\r\n\r\n", etag.c_str(), encoding.c_str(), static_cast<int>(first), static_cast<int>(last), static_cast<int>(content.length()), static_cast<int>(part.length()));
+    mg_send(conn, part.data(), part.length());
+}
+
+void HttpServer::OnRequestServerSentEventsReconnect(mg_connection* conn, mg_http_message* msg) {
+    // Each response continues after the event named by 'Last-Event-ID', the first one ends within an incomplete event
+    mg_str* last_event_id = mg_http_get_header(msg, "Last-Event-ID");
+    const std::string id = last_event_id == nullptr ? "" : std::string{last_event_id->ptr, last_event_id->len};
+    const std::string headers = "Content-Type: text/event-stream\r\n";
+    if (id.empty()) {
+        mg_http_reply(conn, 200, headers.c_str(), "retry: 10\nid: 1\ndata: first\n\ndata: incomplete");
+    } else if (id == "1") {
+        mg_http_reply(conn, 200, headers.c_str(), "id: 2\ndata: second\n\n");
+    } else {
+        // Tells the client to stop reconnecting
+        mg_http_reply(conn, 204, "", "");
+    }
+}
+
+void HttpServer::OnRequestServerSentEventsReconnectClear(mg_connection* conn, mg_http_message* msg) {
+    // Clears the ID set by the client, the reconnect without any 'Last-Event-ID' ends the stream
+    mg_str* last_event_id = mg_http_get_header(msg, "Last-Event-ID");
+    if (last_event_id != nullptr && std::string{last_event_id->ptr, last_event_id->len} == "start") {
+        mg_http_reply(conn, 200, "Content-Type: text/event-stream\r\n", "retry: 600000\nid\ndata: cleared\n\n");
+    } else if (last_event_id == nullptr) {
+        mg_http_reply(conn, 204, "", "");
+    } else {
+        mg_http_reply(conn, 400, "", "");
+    }
+}
+
 void HttpServer::OnRequest(mg_connection* conn, mg_http_message* msg) {
     std::string uri = std::string(msg->uri.ptr, msg->uri.len);
 
@@ -961,6 +1025,12 @@ void HttpServer::OnRequest(mg_connection* conn, mg_http_message* msg) {
         OnRequestCheckExpect100Continue(conn, msg);
     } else if (uri == "/get_download_file_length.html") {
         OnRequestGetDownloadFileLength(conn, msg);
+    } else if (uri == "/range_download.html" || uri == "/range_download_gzip.html" || uri == "/range_download_gzip_only.html") {
+        OnRequestRangeDownload(conn, msg);
+    } else if (uri == "/sse_reconnect.html") {
+        OnRequestServerSentEventsReconnect(conn, msg);
+    } else if (uri == "/sse_reconnect_clear.html") {
+        OnRequestServerSentEventsReconnectClear(conn, msg);
     } else {
         OnRequestNotFound(conn, msg);
     }
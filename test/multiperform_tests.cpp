@@ -124,6 +124,23 @@ TEST(MultiperformGetTests, MultiperformSingleSessionGetTest) {
     EXPECT_EQ(ErrorCode::OK, responses.at(0).error.code);
 }
 
+TEST(MultiperformGetTests, MultiperformResponseFieldsGetTest) {
+    Url url{server->GetBaseUrl() + "/hello.html"};
+    std::shared_ptr<Session> session = std::make_shared<Session>();
+    session->SetUrl(url);
+    MultiPerform multiperform;
+    multiperform.SetResponseFields(ResponseFields::STATUS_CODE);
+    multiperform.AddSession(session);
+    std::vector<Response> responses = multiperform.Get();
+
+    EXPECT_EQ(responses.size(), 1);
+    EXPECT_EQ(std::string{"Hello world!"}, responses.at(0).text);
+    EXPECT_EQ(200, responses.at(0).status_code);
+    EXPECT_TRUE(responses.at(0).url.str().empty());
+    responses.at(0).LoadFields(ResponseFields::URL);
+    EXPECT_EQ(url, responses.at(0).url);
+}
+
 TEST(MultiperformGetTests, MultiperformTwoSessionsGetTest) {
     MultiPerform multiperform;
     std::vector<Url> urls;
@@ -5,6 +5,7 @@
 #include <array>
 #include <cstdio>
 #include <fstream>
+#include <stdexcept>
 #include <string>
 
 #include "cpr/cookies.h"
@@ -31,6 +32,34 @@ TEST(UrlEncodedPostTests, UrlPostSingleTest) {
     EXPECT_EQ(ErrorCode::OK, response.error.code);
 }
 
+TEST(UrlEncodedPostTests, UrlPostPayloadReuseTest) {
+    Url url{server->GetBaseUrl() + "/url_post.html"};
+    Session session;
+    session.SetUrl(url);
+    session.SetPayload(Payload{{"x", "5"}});
+    // The encoded payload gets reused for subsequent requests
+    for (size_t i = 0; i < 2; i++) {
+        Response response = session.Post();
+        std::string expected_text{
+                "{\n"
+                "  \"x\": 5\n"
+                "}"};
+        EXPECT_EQ(expected_text, response.text);
+        EXPECT_EQ(201, response.status_code);
+        EXPECT_EQ(ErrorCode::OK, response.error.code);
+    }
+
+    session.SetPayload(Payload{{"x", "6"}});
+    Response response = session.Post();
+    std::string expected_text{
+            "{\n"
+            "  \"x\": 6\n"
+            "}"};
+    EXPECT_EQ(expected_text, response.text);
+    EXPECT_EQ(201, response.status_code);
+    EXPECT_EQ(ErrorCode::OK, response.error.code);
+}
+
 TEST(UrlEncodedPostTests, UrlPostAddPayloadPair) {
     Url url{server->GetBaseUrl() + "/url_post.html"};
     Payload payload{{"x", "1"}};
@@ -66,6 +95,53 @@ TEST(UrlEncodedPostTests, UrlPostPayloadIteratorTest) {
     EXPECT_EQ(201, response.status_code);
 }
 
+TEST(UrlEncodedPostTests, UrlPostPayloadStreamTest) {
+    Url url{server->GetBaseUrl() + "/url_post.html"};
+    std::vector<Pair> payloadData;
+    payloadData.emplace_back("x", "1");
+    payloadData.emplace_back("y", "2");
+    PayloadStream payload{payloadData.begin(), payloadData.end()};
+    std::string expected_text{
+            "{\n"
+            "  \"x\": 1,\n"
+            "  \"y\": 2,\n"
+            "  \"sum\": 3\n"
+            "}"};
+    Session session;
+    session.SetUrl(url);
+    session.SetPayloadStream(payload);
+    // The pairs get encoded from the beginning for each request
+    for (size_t i = 0; i < 2; i++) {
+        Response response = session.Post();
+        EXPECT_EQ(expected_text, response.text);
+        EXPECT_EQ(std::string{"application/json"}, response.header["content-type"]);
+        EXPECT_EQ(201, response.status_code);
+        EXPECT_EQ(ErrorCode::OK, response.error.code);
+    }
+
+    payload.chunked = true;
+    Response response = cpr::Post(url, payload);
+    EXPECT_EQ(expected_text, response.text);
+    EXPECT_EQ(201, response.status_code);
+    EXPECT_EQ(ErrorCode::OK, response.error.code);
+}
+
+TEST(UrlEncodedPostTests, UrlPostPayloadStreamRedirectTest) {
+    Url url{server->GetBaseUrl() + "/temporary_redirect.html"};
+    std::vector<Pair> payloadData;
+    payloadData.emplace_back("x", "5");
+    // Resending the body after the redirect requires encoding the pairs again
+    Response response = cpr::Post(url, PayloadStream{payloadData.begin(), payloadData.end()}, Header{{"RedirectLocation", "url_post.html"}}, Redirect(PostRedirectFlags::POST_ALL));
+    std::string expected_text{
+            "{\n"
+            "  \"x\": 5\n"
+            "}"};
+    EXPECT_EQ(expected_text, response.text);
+    EXPECT_EQ(Url{server->GetBaseUrl() + "/url_post.html"}, response.url);
+    EXPECT_EQ(201, response.status_code);
+    EXPECT_EQ(ErrorCode::OK, response.error.code);
+}
+
 TEST(UrlEncodedPostTests, UrlPostEncodeTest) {
     Url url{server->GetBaseUrl() + "/url_post.html"};
     Response response = cpr::Post(url, Payload{{"x", "hello world!!~"}});
@@ -435,6 +511,37 @@ TEST(UrlEncodedPostTests, FormPostFileBufferNoCopyTest) {
     EXPECT_EQ(ErrorCode::OK, response.error.code);
 }
 
+TEST(UrlEncodedPostTests, FormPostFileBufferReuseTest) {
+    std::string content{"hello world"};
+    Url url{server->GetBaseUrl() + "/form_post.html"};
+    Session session;
+    session.SetUrl(url);
+    session.SetMultipart(Multipart{{"x", Buffer{content.begin(), content.end(), "test_file"}}});
+    // The multipart gets sent again without being rebuilt
+    for (size_t i = 0; i < 2; i++) {
+        Response response = session.Post();
+        std::string expected_text{
+                "{\n"
+                "  \"x\": \"test_file=" +
+                content +
+                "\"\n"
+                "}"};
+        EXPECT_EQ(expected_text, response.text);
+        EXPECT_EQ(201, response.status_code);
+        EXPECT_EQ(ErrorCode::OK, response.error.code);
+    }
+
+    session.SetMultipart(Multipart{{"x", 5}});
+    Response response = session.Post();
+    std::string expected_text{
+            "{\n"
+            "  \"x\": \"5\"\n"
+            "}"};
+    EXPECT_EQ(expected_text, response.text);
+    EXPECT_EQ(201, response.status_code);
+    EXPECT_EQ(ErrorCode::OK, response.error.code);
+}
+
 TEST(UrlEncodedPostTests, FormPostFileBufferPointerTest) {
     const char* content = "hello world";
     Url url{server->GetBaseUrl() + "/form_post.html"};
@@ -705,6 +812,89 @@ TEST(UrlEncodedPostTests, PostBodyWithFile) {
     EXPECT_EQ(200, response.status_code);
 }
 
+TEST(UrlEncodedPostTests, PostBodyCompressedTest) {
+    if (!RequestCompression::IsSupported(RequestCompressionMethod::gzip)) {
+        GTEST_SKIP() << "Built without zlib";
+    }
+    Url url{server->GetBaseUrl() + "/post_reflect.html"};
+    const std::string body(1024 * 1024, 'x');
+    const std::string compressed = util::Compressor::CompressAll(RequestCompression{}, body);
+    Response response = cpr::Post(url, cpr::Body{body}, RequestCompression{});
+    EXPECT_EQ(200, response.status_code);
+    EXPECT_EQ(ErrorCode::OK, response.error.code);
+    EXPECT_EQ(std::string{"gzip"}, response.header["Content-Encoding"]);
+    EXPECT_EQ(static_cast<cpr_off_t>(compressed.size()), response.uploaded_bytes);
+}
+
+TEST(UrlEncodedPostTests, PostBodyReuseTest) {
+    Url url{server->GetBaseUrl() + "/post_reflect.html"};
+    Session session;
+    session.SetUrl(url);
+    session.SetBody(Body(std::string(1024 * 1024, 'x')));
+    for (size_t i = 0; i < 2; i++) {
+        Response response = session.Post();
+        EXPECT_EQ(std::string(1024 * 1024, 'x'), response.text);
+        EXPECT_EQ(200, response.status_code);
+        EXPECT_EQ(ErrorCode::OK, response.error.code);
+    }
+
+    session.SetBody(Body{"Hello world!"});
+    Response response = session.Post();
+    EXPECT_EQ(std::string{"Hello world!"}, response.text);
+    EXPECT_EQ(200, response.status_code);
+
+    // No body gets sent once the content is removed
+    session.RemoveContent();
+    response = session.Post();
+    EXPECT_TRUE(response.text.empty());
+    EXPECT_EQ(200, response.status_code);
+}
+
+TEST(UrlEncodedPostTests, PostFileBodyTest) {
+    std::string filename{"test_file_body"};
+    std::string expected_text(R"({"property1": "value1"})");
+    std::ofstream test_file;
+    test_file.open(filename);
+    test_file << expected_text;
+    test_file.close();
+    Url url{server->GetBaseUrl() + "/post_reflect.html"};
+    Session session;
+    session.SetUrl(url);
+    session.SetHeader(Header{{"Content-Type", "application/octet-stream"}});
+    session.SetFileBody(FileBody{filename});
+    // The file gets read from the beginning for each request
+    for (size_t i = 0; i < 2; i++) {
+        Response response = session.Post();
+        EXPECT_EQ(expected_text, response.text);
+        EXPECT_EQ(url, response.url);
+        EXPECT_EQ(ErrorCode::OK, response.error.code);
+        EXPECT_EQ(std::string{"application/octet-stream"}, response.header["content-type"]);
+        EXPECT_EQ(200, response.status_code);
+    }
+    std::remove(filename.c_str());
+}
+
+TEST(UrlEncodedPostTests, PostFileBodyRedirectTest) {
+    std::string filename{"test_file_body_redirect"};
+    std::string expected_text(R"({"property1": "value1"})");
+    std::ofstream test_file;
+    test_file.open(filename);
+    test_file << expected_text;
+    test_file.close();
+    Url url{server->GetBaseUrl() + "/temporary_redirect.html"};
+    // Resending the body after the redirect requires rewinding the file
+    Response response = cpr::Post(url, FileBody{File{filename}}, Header{{"RedirectLocation", "post_reflect.html"}}, Redirect(PostRedirectFlags::POST_ALL));
+    EXPECT_EQ(expected_text, response.text);
+    EXPECT_EQ(Url{server->GetBaseUrl() + "/post_reflect.html"}, response.url);
+    EXPECT_EQ(ErrorCode::OK, response.error.code);
+    EXPECT_EQ(200, response.status_code);
+    std::remove(filename.c_str());
+}
+
+TEST(UrlEncodedPostTests, PostFileBodyMissingFileTest) {
+    EXPECT_THROW(FileBody{"this_file_does_not_exist"}, std::invalid_argument);
+}
+
 TEST(UrlEncodedPostTests, PostBodyWithBuffer) {
     Url url{server->GetBaseUrl() + "/post_reflect.html"};
     std::string expected_text(R"({"property1": "value1"})");
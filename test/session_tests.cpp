@@ -1,11 +1,14 @@
 #include <algorithm>
+#include <array>
 #include <chrono>
 #include <cstdint>
 #include <cstdlib>
+#include <iterator>
 #include <gtest/gtest.h>
 
 #include <stdexcept>
 #include <string>
+#include <string_view>
 
 #include "cpr/cpr.h"
 #include <curl/curl.h>
@@ -857,6 +860,22 @@ TEST(CookiesTests, BasicCookiesTest) {
     }
 }
 
+TEST(CookiesTests, DisabledCookieEngineTest) {
+    Url url{server->GetBaseUrl() + "/basic_cookies.html"};
+    Session session{};
+    session.SetUrl(url);
+    session.SetCookieEngine(false);
+    Response response = session.Get();
+    EXPECT_EQ(200, response.status_code);
+    EXPECT_EQ(ErrorCode::OK, response.error.code);
+    EXPECT_EQ(std::string{"Basic Cookies"}, response.text);
+    EXPECT_TRUE(response.cookies.empty());
+
+    session.SetCookieEngine(true);
+    response = session.Get();
+    EXPECT_FALSE(response.cookies.empty());
+}
+
 TEST(CookiesTests, ClientSetCookiesTest) {
     Url url{server->GetBaseUrl() + "/cookies_reflect.html"};
     {
@@ -934,6 +953,35 @@ TEST(CookiesTests, RedirectionWithChangingCookiesTest) {
     }
 }
 
+TEST(CookiesTests, SharedCookieJarTest) {
+    CookieJar jar;
+    jar.Add(Cookie{"theme", "dark", "127.0.0.1"});
+    {
+        Session session{};
+        session.SetUrl(Url{server->GetBaseUrl() + "/basic_cookies.html"});
+        session.SetCookieJar(jar);
+        Response response = session.Get();
+        EXPECT_EQ(200, response.status_code);
+        EXPECT_EQ(ErrorCode::OK, response.error.code);
+        EXPECT_TRUE(response.cookies.empty());
+    }
+    const Cookies stored = jar.GetCookies();
+    EXPECT_EQ(std::distance(stored.begin(), stored.end()), 3);
+
+    Session session{};
+    session.SetUrl(Url{server->GetBaseUrl() + "/cookies_reflect.html"});
+    session.SetCookieJar(jar);
+    // Adds to the cookies of the jar instead of replacing them
+    session.SetCookies(Cookies{{"extra", "1"}});
+    Response response = session.Get();
+    EXPECT_EQ(200, response.status_code);
+    EXPECT_EQ(ErrorCode::OK, response.error.code);
+    EXPECT_NE(response.text.find("theme=dark"), std::string::npos);
+    EXPECT_NE(response.text.find("SID=31d4d96e407aad42"), std::string::npos);
+    EXPECT_NE(response.text.find("lang=en-US"), std::string::npos);
+    EXPECT_NE(response.text.find("extra=1"), std::string::npos);
+}
+
 TEST(DifferentMethodTests, GetPostTest) {
     Url url{server->GetBaseUrl() + "/header_reflect.html"};
     Session session;
@@ -1267,6 +1315,201 @@ TEST(BasicTests, ReserveResponseString) {
     EXPECT_EQ(ErrorCode::OK, response.error.code);
 }
 
+TEST(BasicTests, AutoReserveResponseString) {
+    Url url{server->GetBaseUrl() + "/hello.html"};
+    Session session;
+    session.SetUrl(url);
+    session.SetAutoReserveSize(4096);
+    Response response = session.Get();
+    std::string expected_text{"Hello world!"};
+    EXPECT_EQ(expected_text, response.text);
+    EXPECT_EQ(url, response.url);
+    EXPECT_EQ(std::string{"text/html"}, response.header["content-type"]);
+    EXPECT_EQ(std::to_string(expected_text.size()), response.header["content-length"]);
+    EXPECT_EQ(200, response.status_code);
+    EXPECT_EQ(ErrorCode::OK, response.error.code);
+}
+
+TEST(BasicTests, ResponseFieldsTest) {
+    Url url{server->GetBaseUrl() + "/hello.html"};
+    Session session;
+    session.SetUrl(url);
+    session.SetResponseFields(ResponseFields::STATUS_CODE);
+    Response response = session.Get();
+    EXPECT_EQ(std::string{"Hello world!"}, response.text);
+    EXPECT_EQ(200, response.status_code);
+    EXPECT_EQ(ErrorCode::OK, response.error.code);
+    EXPECT_EQ(ResponseFields::STATUS_CODE, response.GetLoadedFields());
+    EXPECT_TRUE(response.url.str().empty());
+    EXPECT_TRUE(response.header.empty());
+    EXPECT_TRUE(response.status_line.empty());
+    EXPECT_FALSE(response.raw_header.empty());
+    // The view does not depend on HEADER being loaded
+    EXPECT_EQ(response.GetHeaderView()["content-type"], "text/html");
+
+    response.LoadFields(ResponseFields::URL | ResponseFields::HEADER);
+    EXPECT_EQ(url, response.url);
+    const std::string content_type = response.header["content-type"];
+    EXPECT_EQ(std::string{"text/html"}, content_type);
+    EXPECT_EQ(std::string{"HTTP/1.1 200 OK"}, response.status_line);
+    EXPECT_EQ(ResponseFields::STATUS_CODE | ResponseFields::URL | ResponseFields::HEADER, response.GetLoadedFields());
+
+    session.SetResponseFields(ResponseFields::ALL);
+    response = session.Get();
+    EXPECT_EQ(url, response.url);
+    EXPECT_EQ(ResponseFields::ALL, response.GetLoadedFields());
+}
+
+TEST(BasicTests, ResponseFieldsAfterNextRequestTest) {
+    Url url{server->GetBaseUrl() + "/hello.html"};
+    Session session;
+    session.SetUrl(url);
+    session.SetResponseFields(ResponseFields::STATUS_CODE);
+    Response first = session.Get();
+    session.SetUrl(Url{server->GetBaseUrl() + "/basic.json"});
+    Response second = session.Get();
+
+    // The handle describes the second request now, so the first one must not read its fields from it
+    EXPECT_THROW(first.LoadFields(ResponseFields::URL), std::logic_error);
+    EXPECT_TRUE(first.url.str().empty());
+    EXPECT_THROW(first.Detach(), std::logic_error);
+    EXPECT_FALSE(first.IsDetached());
+    // Already loaded fields and the header do not need the handle
+    EXPECT_NO_THROW(first.LoadFields(ResponseFields::STATUS_CODE | ResponseFields::HEADER));
+    EXPECT_EQ(std::string{"text/html"}, first.header["content-type"]);
+
+    second.LoadFields(ResponseFields::URL);
+    EXPECT_EQ(Url{server->GetBaseUrl() + "/basic.json"}, second.url);
+}
+
+TEST(BasicTests, DetachResponseTest) {
+    Url url{server->GetBaseUrl() + "/hello.html"};
+    Session session;
+    session.SetUrl(url);
+    session.SetResponseFields(ResponseFields::STATUS_CODE);
+    Response response = session.Get();
+    EXPECT_FALSE(response.IsDetached());
+    response.Detach();
+    EXPECT_TRUE(response.IsDetached());
+    // All fields got loaded before releasing the handle
+    EXPECT_EQ(ResponseFields::ALL, response.GetLoadedFields());
+    EXPECT_EQ(url, response.url);
+    EXPECT_EQ(std::string{"text/html"}, response.header["content-type"]);
+    EXPECT_TRUE(response.GetCertInfos().empty());
+
+    session.SetOption(DetachResponse{});
+    response = session.Get();
+    EXPECT_TRUE(response.IsDetached());
+    EXPECT_EQ(std::string{"Hello world!"}, response.text);
+    EXPECT_EQ(200, response.status_code);
+    EXPECT_EQ(url, response.url);
+    EXPECT_EQ(ErrorCode::OK, response.error.code);
+}
+
+TEST(BasicTests, RequestArenaTest) {
+    Url url{server->GetBaseUrl() + "/header_reflect.html"};
+    Session session;
+    session.SetUrl(url);
+    // Exceeds the initial buffer of the arena, so the rest of the list has to come from the heap
+    const std::string long_value(512, 'x');
+    session.SetHeader(Header{{"hello", "world"}, {"key", "value"}, {"long", long_value}});
+    session.SetParameters(Parameters{{"key", "value"}});
+    session.SetRequestArena(RequestArena{256});
+    for (size_t i = 0; i < 2; i++) {
+        Response response = session.Get();
+        EXPECT_EQ(200, response.status_code);
+        EXPECT_EQ(std::string{"world"}, response.header["hello"]);
+        EXPECT_EQ(std::string{"value"}, response.header["key"]);
+        EXPECT_EQ(long_value, response.header["long"]);
+        EXPECT_EQ(Url{url + "?key=value"}, response.url);
+        EXPECT_EQ(ErrorCode::OK, response.error.code);
+    }
+}
+
+TEST(BasicTests, BufferPoolTest) {
+    Url url{server->GetBaseUrl() + "/hello.html"};
+    BufferPool pool;
+    Session session;
+    session.SetUrl(url);
+    session.SetReserveSize(4096);
+    session.SetBufferPool(pool);
+    {
+        Response response = session.Get();
+        EXPECT_EQ(std::string{"Hello world!"}, response.text);
+        EXPECT_EQ(200, response.status_code);
+        EXPECT_EQ(0, pool.GetSize());
+    }
+    // Body and header buffer got returned
+    EXPECT_EQ(2, pool.GetSize());
+
+    Response response = session.Get();
+    EXPECT_EQ(std::string{"Hello world!"}, response.text);
+    EXPECT_GE(response.text.capacity(), 4096);
+    EXPECT_EQ(0, pool.GetSize());
+}
+
+TEST(BasicTests, TimingsTest) {
+    Url url{server->GetBaseUrl() + "/hello.html"};
+    Session session;
+    session.SetUrl(url);
+    Response response = session.Get();
+    EXPECT_EQ(200, response.status_code);
+    EXPECT_GT(response.timings.total.count(), 0);
+    EXPECT_LE(response.timings.name_lookup, response.timings.connect);
+    EXPECT_LE(response.timings.connect, response.timings.pre_transfer);
+    EXPECT_LE(response.timings.pre_transfer, response.timings.start_transfer);
+    EXPECT_LE(response.timings.start_transfer, response.timings.total);
+    EXPECT_EQ(0, response.timings.app_connect.count());
+    EXPECT_EQ(0, response.timings.redirect.count());
+
+    session.SetResponseFields(ResponseFields::ALL ^ ResponseFields::TIMINGS);
+    response = session.Get();
+    EXPECT_EQ(0, response.timings.total.count());
+}
+
+TEST(BasicTests, ResponseSinkTest) {
+    Url url{server->GetBaseUrl() + "/hello.html"};
+    Session session;
+    session.SetUrl(url);
+    std::shared_ptr<ChunkedSink> sink = std::make_shared<ChunkedSink>(4);
+    for (size_t i = 0; i < 2; i++) {
+        session.SetResponseSink(sink);
+        Response response = session.Get();
+        std::string expected_text{"Hello world!"};
+        EXPECT_TRUE(response.text.empty());
+        EXPECT_EQ(sink, response.sink);
+        EXPECT_EQ(expected_text, sink->GetString());
+        EXPECT_EQ(url, response.url);
+        EXPECT_EQ(200, response.status_code);
+        EXPECT_EQ(ErrorCode::OK, response.error.code);
+    }
+
+    // The sink only gets used for a single request, so earlier responses keep their body
+    session.SetResponseSink(sink);
+    Response first = session.Get();
+    Response second = session.Get();
+    EXPECT_EQ(sink, first.sink);
+    EXPECT_EQ(std::string{"Hello world!"}, first.sink->GetString());
+    EXPECT_EQ(std::string{"Hello world!"}, second.text);
+    EXPECT_EQ(nullptr, second.sink);
+
+    session.SetResponseSink(sink);
+    session.SetResponseSink(nullptr);
+    Response response = session.Get();
+    EXPECT_EQ(std::string{"Hello world!"}, response.text);
+    EXPECT_EQ(nullptr, response.sink);
+}
+
+TEST(BasicTests, ResponseSinkOverflowTest) {
+    Url url{server->GetBaseUrl() + "/hello.html"};
+    std::array<char, 5> buffer{};
+    std::shared_ptr<BufferSink> sink = std::make_shared<BufferSink>(buffer.data(), buffer.size());
+    Response response = cpr::Get(url, sink);
+    EXPECT_TRUE(sink->IsOverflown());
+    EXPECT_EQ(std::string_view{"Hello"}, sink->GetView());
+    EXPECT_EQ(ErrorCode::WRITE_ERROR, response.error.code);
+}
+
 std::vector<std::string> Split(const std::string& s) {
     std::vector<std::string> encodings;
     std::stringstream ss(s);
@@ -1347,6 +1590,19 @@ TEST(BasicTests, AcceptEncodingTestWithCostomizedStringLValue) {
     CompareEncodings(response.text, std::vector<std::string>{"deflate", "gzip", "zlib"});
 }
 
+TEST(BasicTests, AcceptEncodingTestBrotliZstd) {
+    Url url{server->GetBaseUrl() + "/check_accept_encoding.html"};
+    Session session;
+    session.SetUrl(url);
+    // Decoded by cpr itself in case curl has been built without them
+    session.SetAcceptEncoding({AcceptEncodingMethods::br, AcceptEncodingMethods::zstd, AcceptEncodingMethods::gzip});
+    Response response = session.Get();
+
+    EXPECT_EQ(200, response.status_code);
+    EXPECT_EQ(ErrorCode::OK, response.error.code);
+    CompareEncodings(response.text, std::vector<std::string>{"br", "zstd", "gzip"});
+}
+
 TEST(BasicTests, AcceptEncodingTestDisabled) {
     Url url{server->GetBaseUrl() + "/header_reflect.html"};
     Session session;
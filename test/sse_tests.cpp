@@ -1,7 +1,10 @@
 #include <gtest/gtest.h>
 
+#include <atomic>
 #include <chrono>
+#include <memory>
 #include <string>
+#include <string_view>
 #include <thread>
 #include <vector>
 
@@ -199,6 +202,54 @@ TEST(SSETests, SSEParserChunkedDataTest) {
     EXPECT_EQ(events[0].data, "Partial event");
 }
 
+TEST(SSETests, SSEParserSplitAtEveryPositionTest) {
+    const std::string sse_data =
+            "id: 1\r\n"
+            "event: update\r\n"
+            "data: first line\r\n"
+            "data: second line\r\n"
+            "\r\n"
+            ": comment\n"
+            "retry: 500\n"
+            "data: {\"token\":\"x\"}\n"
+            "\n";
+
+    for (size_t split = 0; split <= sse_data.size(); split++) {
+        ServerSentEventParser parser;
+        std::vector<ServerSentEvent> events;
+        const auto collect = [&events](ServerSentEvent&& event) {
+            events.push_back(std::move(event));
+            return true;
+        };
+        EXPECT_TRUE(parser.parse(std::string_view{sse_data}.substr(0, split), collect));
+        EXPECT_TRUE(parser.parse(std::string_view{sse_data}.substr(split), collect));
+
+        ASSERT_EQ(events.size(), 2) << "split at " << split;
+        EXPECT_EQ(events[0].id, "1");
+        EXPECT_EQ(events[0].event, "update");
+        EXPECT_EQ(events[0].data, "first line\nsecond line");
+        EXPECT_EQ(events[1].data, "{\"token\":\"x\"}");
+        EXPECT_EQ(events[1].retry, 500);
+    }
+}
+
+TEST(SSETests, SSEParserContinueAfterAbortTest) {
+    ServerSentEventParser parser;
+    std::vector<std::string> data;
+    const auto collect = [&data](ServerSentEvent&& event) {
+        data.push_back(std::move(event.data));
+        return data.size() != 1;
+    };
+
+    EXPECT_FALSE(parser.parse("data: First\n\ndata: Second\n\ndata: Th", collect));
+    ASSERT_EQ(data.size(), 1);
+    // The rest of the aborted chunk gets parsed together with the next one
+    EXPECT_TRUE(parser.parse("ird\n\n", collect));
+    ASSERT_EQ(data.size(), 3);
+    EXPECT_EQ(data[1], "Second");
+    EXPECT_EQ(data[2], "Third");
+}
+
 TEST(SSETests, SSEParserCRLFTest) {
     ServerSentEventParser parser;
     std::vector<ServerSentEvent> events;
@@ -232,6 +283,112 @@ TEST(SSETests, SSEParserFieldWithoutColonTest) {
     EXPECT_EQ(events[0].data, "Some actual data\n");
 }
 
+TEST(SSETests, SSEParserLastEventIdTest) {
+    ServerSentEventParser parser;
+    const auto ignore = [](ServerSentEvent&& /*event*/) { return true; };
+    EXPECT_FALSE(parser.lastEventId().has_value());
+
+    parser.parse("retry: 250\nid: 7\ndata: a\n\nid: 8\ndata: incomplete\n", ignore);
+    EXPECT_EQ(parser.lastEventId(), "7");
+    EXPECT_EQ(parser.retry(), 250);
+
+    // The incomplete event gets dropped together with its ID
+    parser.discardEvent();
+    parser.parse("\n", ignore);
+    EXPECT_EQ(parser.lastEventId(), "7");
+
+    // Events without data still update the ID, an empty one clears it
+    parser.parse("id: 9\n\n", ignore);
+    EXPECT_EQ(parser.lastEventId(), "9");
+    parser.parse("id\n\n", ignore);
+    EXPECT_EQ(parser.lastEventId(), "");
+
+    parser.reset();
+    EXPECT_FALSE(parser.lastEventId().has_value());
+    EXPECT_FALSE(parser.retry().has_value());
+}
+
+TEST(SSETests, SSEReconnectTest) {
+    std::vector<std::string> data;
+    Session session;
+    session.SetUrl(Url{server->GetBaseUrl() + "/sse_reconnect.html"});
+    session.SetServerSentEventCallback(ServerSentEventCallback{[&data](ServerSentEvent&& event, intptr_t /*userdata*/) {
+        data.push_back(std::move(event.data));
+        return true;
+    }});
+    session.SetServerSentEventReconnect(ServerSentEventReconnect{3});
+    Response response = session.Get();
+
+    // Reconnected using 'Last-Event-ID' until the server responded with 204 No Content
+    EXPECT_EQ(204, response.status_code);
+    EXPECT_EQ(ErrorCode::OK, response.error.code);
+    EXPECT_EQ(data, (std::vector<std::string>{"first", "second"}));
+    EXPECT_EQ(session.GetHeader().count("Last-Event-ID"), 0);
+}
+
+TEST(SSETests, SSEReconnectClearedIdTest) {
+    std::vector<std::string> data;
+    Session session;
+    session.SetUrl(Url{server->GetBaseUrl() + "/sse_reconnect_clear.html"});
+    session.SetHeader(Header{{"Last-Event-ID", "start"}});
+    session.SetServerSentEventCallback(ServerSentEventCallback{[&data](ServerSentEvent&& event, intptr_t /*userdata*/) {
+        data.push_back(std::move(event.data));
+        return true;
+    }});
+    // The reconnection time of 10 minutes sent by the server gets limited to max_retry
+    session.SetServerSentEventReconnect(ServerSentEventReconnect{3, std::chrono::milliseconds{10}, std::chrono::milliseconds{20}});
+    Response response = session.Get();
+
+    // The stream cleared the ID, so the reconnect did not send one anymore
+    EXPECT_EQ(204, response.status_code);
+    EXPECT_EQ(ErrorCode::OK, response.error.code);
+    EXPECT_EQ(data, (std::vector<std::string>{"cleared"}));
+    EXPECT_LT(response.elapsed, 10);
+    EXPECT_EQ(session.GetHeader().at("Last-Event-ID"), "start");
+}
+
+TEST(SSETests, SSEReconnectJitterLimitTest) {
+    Session session;
+    session.SetUrl(Url{server->GetBaseUrl() + "/sse_reconnect_clear.html"});
+    session.SetHeader(Header{{"Last-Event-ID", "start"}});
+    session.SetServerSentEventCallback(ServerSentEventCallback{[](ServerSentEvent&& /*event*/, intptr_t /*userdata*/) { return true; }});
+    // The server asks for 10 minutes, the random part must not push the wait beyond max_retry either
+    session.SetServerSentEventReconnect(ServerSentEventReconnect{3, std::chrono::milliseconds{10}, std::chrono::milliseconds{400}});
+    const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    Response response = session.Get();
+    const std::chrono::steady_clock::duration waited = std::chrono::steady_clock::now() - start;
+
+    EXPECT_EQ(204, response.status_code);
+    EXPECT_GE(waited, std::chrono::milliseconds{400});
+    EXPECT_LT(waited, std::chrono::milliseconds{500});
+}
+
+TEST(SSETests, SSEReconnectCancelWaitTest) {
+    std::vector<std::string> data;
+    const std::shared_ptr<std::atomic_bool> cancelled = std::make_shared<std::atomic_bool>(false);
+    Session session;
+    session.SetUrl(Url{server->GetBaseUrl() + "/sse_reconnect_clear.html"});
+    session.SetHeader(Header{{"Last-Event-ID", "start"}});
+    session.SetServerSentEventCallback(ServerSentEventCallback{[&data](ServerSentEvent&& event, intptr_t /*userdata*/) {
+        data.push_back(std::move(event.data));
+        return true;
+    }});
+    session.SetServerSentEventReconnect(ServerSentEventReconnect{3, std::chrono::milliseconds{60000}, std::chrono::milliseconds{60000}});
+    session.SetCancellationParam(cancelled);
+    std::thread canceller{[&cancelled] {
+        std::this_thread::sleep_for(std::chrono::milliseconds{500});
+        cancelled->store(true);
+    }};
+    const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    Response response = session.Get();
+    canceller.join();
+
+    // Cancelling ends the wait for the reconnect instead of only the next transfer
+    EXPECT_EQ(ErrorCode::ABORTED_BY_CALLBACK, response.error.code);
+    EXPECT_EQ(data, (std::vector<std::string>{"cleared"}));
+    EXPECT_LT(std::chrono::steady_clock::now() - start, std::chrono::seconds{30});
+}
+
 TEST(SSETests, SSECallbackTest) {
     ServerSentEventCallback callback(
             [](ServerSentEvent&& /*event*/, intptr_t userdata) {
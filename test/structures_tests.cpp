@@ -1,10 +1,36 @@
 #include "cpr/cprtypes.h"
 #include <gtest/gtest.h>
 
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+#include <iterator>
+#include <cstddef>
+#include <memory_resource>
+#include <optional>
+#include <stdexcept>
 #include <string>
+#include <string_view>
+#include <system_error>
+#include <vector>
 
+#include "cpr/buffer_pool.h"
+#include "cpr/content_decoder.h"
+#include "cpr/cookie_jar.h"
+#include "cpr/file_body.h"
+#include "cpr/file_sink.h"
 #include "cpr/parameters.h"
 #include "cpr/payload.h"
+#include "cpr/payload_stream.h"
+#include "cpr/request_arena.h"
+#include "cpr/request_compression.h"
+#include "cpr/response.h"
+#include "cpr/response_fields.h"
+#include "cpr/response_sink.h"
+#include "cpr/resumable_download.h"
+#include "cpr/session.h"
 
 using namespace cpr;
 
@@ -60,12 +86,519 @@ TEST(ParametersTests, NoCurlHolderTest) {
     EXPECT_EQ(parameters.GetContent(), expected);
 }
 
+TEST(ParametersTests, ContentCacheTest) {
+    Parameters parameters{{"a b", "c&d"}, {"flag", ""}};
+    EXPECT_EQ(parameters.GetContent(CurlHolder()), "a%20b=c%26d&flag");
+    EXPECT_EQ(parameters.GetContent(), "a b=c&d&flag");
+
+    // Changes invalidate the cached content
+    parameters.Add({"e", "f/g"});
+    EXPECT_EQ(parameters.GetContent(CurlHolder()), "a%20b=c%26d&flag&e=f%2Fg");
+    parameters.encode = false;
+    EXPECT_EQ(parameters.GetContent(CurlHolder()), "a b=c&d&flag&e=f/g");
+    parameters.encode = true;
+
+    const Parameters copy{parameters};
+    parameters.Add({"h", "i"});
+    EXPECT_EQ(copy.GetContent(CurlHolder()), "a%20b=c%26d&flag&e=f%2Fg");
+    EXPECT_EQ(parameters.GetContent(CurlHolder()), "a%20b=c%26d&flag&e=f%2Fg&h=i");
+    EXPECT_EQ(Parameters{}.GetContent(CurlHolder()), "");
+}
+
+TEST(ParametersTests, ContentFromResourceTest) {
+    const Parameters parameters{{"a b", "c&d"}, {"long", std::string(64, 'x')}};
+    std::array<std::byte, 256> buffer{};
+    std::pmr::monotonic_buffer_resource resource{buffer.data(), buffer.size(), std::pmr::null_memory_resource()};
+    // Allocated from the given buffer only, since the upstream resource refuses any allocation
+    const std::pmr::string content = parameters.GetContent(CurlHolder(), &resource);
+    EXPECT_EQ(std::string_view{content}, "a%20b=c%26d&long=" + std::string(64, 'x'));
+    EXPECT_EQ(content.get_allocator().resource(), &resource);
+}
+
+TEST(ParametersTests, EmptyParameterTest) {
+    // Empty parameters do not get a separator in front of the following one
+    EXPECT_EQ((Parameters{{"", ""}, {"a", "b"}}.GetContent(CurlHolder())), "a=b");
+    EXPECT_EQ((Parameters{{"", ""}, {"", ""}, {"a", "b"}}.GetContent()), "a=b");
+    EXPECT_EQ((Parameters{{"a", "b"}, {"", ""}, {"c", "d"}}.GetContent(CurlHolder())), "a=b&&c=d");
+    EXPECT_EQ((Parameters{{"", ""}}.GetContent(CurlHolder())), "");
+}
+
+TEST(PayloadTests, ContentCacheTest) {
+    Payload payload{{"x y", "1 2"}, {"empty", ""}};
+    EXPECT_EQ(payload.GetContent(CurlHolder()), "x y=1%202&empty=");
+    payload.Add({"k", "~v"});
+    EXPECT_EQ(payload.GetContent(CurlHolder()), "x y=1%202&empty=&k=~v");
+}
+
+TEST(PayloadStreamTests, ReadTest) {
+    std::vector<Pair> pairs;
+    for (size_t i = 0; i < 1000; i++) {
+        pairs.emplace_back("key" + std::to_string(i), "value " + std::to_string(i) + "&/");
+    }
+    const std::string expected = Payload(pairs.begin(), pairs.end()).GetContent(CurlHolder());
+    PayloadStream payload{pairs.begin(), pairs.end()};
+    EXPECT_EQ(payload.GetSize(), static_cast<cpr_off_t>(expected.size()));
+
+    // Buffers smaller than a single pair as well as ones holding many of them
+    for (const size_t buffer_size : {1, 7, 4096}) {
+        payload.Rewind();
+        std::string result;
+        std::string buffer(buffer_size, '\0');
+        size_t read = 0;
+        while ((read = payload.Read(buffer.data(), buffer.size())) > 0) {
+            result.append(buffer.data(), read);
+        }
+        EXPECT_EQ(result, expected);
+    }
+}
+
+TEST(PayloadStreamTests, DisableEncodingTest) {
+    const std::vector<Pair> pairs{{"a", "b c"}, {"d", ""}};
+    PayloadStream payload{pairs.begin(), pairs.end()};
+    payload.encode = false;
+    EXPECT_EQ(payload.GetSize(), 8);
+    std::string buffer(64, '\0');
+    buffer.resize(payload.Read(buffer.data(), buffer.size()));
+    EXPECT_EQ(buffer, "a=b c&d=");
+    EXPECT_EQ(payload.Read(buffer.data(), buffer.size()), 0);
+}
+
+TEST(CookieJarTests, AddClearTest) {
+    CookieJar jar;
+    EXPECT_TRUE(jar.GetCookies().empty());
+    const std::chrono::system_clock::time_point expires = std::chrono::system_clock::from_time_t(4102444800); // 2100-01-01
+    jar.Add(Cookies{
+            {"session", "1", "example.com"},
+            {"lang", "en-US", "example.com", true, "/docs", true, expires},
+    });
+    // Replaces the cookie with the same name, domain and path
+    jar.Add(Cookie{"session", "2", "example.com"});
+
+    const Cookies cookies = jar.GetCookies();
+    ASSERT_EQ(std::distance(cookies.begin(), cookies.end()), 2);
+    const auto lang = std::find_if(cookies.begin(), cookies.end(), [](const Cookie& c) { return c.GetName() == "lang"; });
+    ASSERT_NE(lang, cookies.end());
+    EXPECT_EQ(lang->GetValue(), "en-US");
+    EXPECT_TRUE(lang->IsIncludingSubdomains());
+    EXPECT_EQ(lang->GetPath(), "/docs");
+    EXPECT_TRUE(lang->IsHttpsOnly());
+    EXPECT_EQ(lang->GetExpires(), expires);
+    const auto session = std::find_if(cookies.begin(), cookies.end(), [](const Cookie& c) { return c.GetName() == "session"; });
+    ASSERT_NE(session, cookies.end());
+    EXPECT_EQ(session->GetValue(), "2");
+
+    // Copies share the same cookies
+    CookieJar copy{jar};
+    copy.ClearSessionCookies();
+    const Cookies remaining = jar.GetCookies();
+    ASSERT_EQ(std::distance(remaining.begin(), remaining.end()), 1);
+    EXPECT_EQ(remaining.begin()->GetName(), "lang");
+    jar.Clear();
+    EXPECT_TRUE(copy.GetCookies().empty());
+}
+
+TEST(CookieJarTests, InvalidCookieTest) {
+    CookieJar jar;
+    EXPECT_THROW(jar.Add(Cookie{"name", "value"}), std::invalid_argument);
+    EXPECT_THROW(jar.Add(Cookie{"name", "a\tb", "example.com"}), std::invalid_argument);
+    EXPECT_TRUE(jar.GetCookies().empty());
+}
+
+TEST(CookieJarTests, ConnectionPoolConflictTest) {
+    ConnectionPool pool;
+    CookieJar jar;
+    {
+        Session session;
+        session.SetCookieJar(jar);
+        EXPECT_THROW(session.SetConnectionPool(pool), std::invalid_argument);
+    }
+    {
+        Session session;
+        session.SetConnectionPool(pool);
+        EXPECT_THROW(session.SetCookieJar(jar), std::invalid_argument);
+    }
+
+    // A jar created from the pool shares the same handle, so both can be set in any order
+    ConnectionPool shared_pool;
+    const CookieJar shared_jar{shared_pool};
+    EXPECT_TRUE(shared_jar.IsSharedWith(shared_pool));
+    EXPECT_FALSE(jar.IsSharedWith(shared_pool));
+    Session session;
+    EXPECT_NO_THROW(session.SetConnectionPool(shared_pool));
+    EXPECT_NO_THROW(session.SetCookieJar(shared_jar));
+    EXPECT_NO_THROW(session.SetConnectionPool(ConnectionPool{shared_pool}));
+}
+
 TEST(UrlToAndFromString, UrlTests) {
     std::string s{"https://github.com/whoshuu/cpr"};
     cpr::Url url = s;
     EXPECT_EQ(s, url.str());
 }
 
+TEST(BufferPoolTests, AcquireReleaseTest) {
+    BufferPool pool{2, 1024};
+    EXPECT_EQ(pool.GetSize(), 0);
+    EXPECT_TRUE(pool.Acquire().empty());
+
+    std::string buffer(512, 'x');
+    const size_t capacity = buffer.capacity();
+    pool.Release(std::move(buffer));
+    EXPECT_EQ(pool.GetSize(), 1);
+
+    // Copies share the same buffers
+    BufferPool copy{pool};
+    std::string reused = copy.Acquire();
+    EXPECT_TRUE(reused.empty());
+    EXPECT_EQ(reused.capacity(), capacity);
+    EXPECT_EQ(pool.GetSize(), 0);
+}
+
+TEST(BufferPoolTests, LimitsTest) {
+    BufferPool pool{2, 1024};
+    // Too small to be worth keeping
+    pool.Release(std::string{"small"});
+    // Too large
+    pool.Release(std::string(2048, 'x'));
+    EXPECT_EQ(pool.GetSize(), 0);
+
+    for (size_t i = 0; i < 3; i++) {
+        pool.Release(std::string(512, 'x'));
+    }
+    EXPECT_EQ(pool.GetSize(), 2);
+}
+
+TEST(FileBodyTests, ReadSeekTest) {
+    const std::string filename{"structures_file_body"};
+    std::ofstream{filename} << "Hello world!";
+    const FileBody body{filename};
+    EXPECT_EQ(body.GetPath(), filename);
+    EXPECT_EQ(body.GetSize(), 12);
+
+    std::array<char, 8> buffer{};
+    EXPECT_EQ(body.Read(buffer.data(), buffer.size()), 8);
+    EXPECT_EQ(std::string_view(buffer.data(), 8), "Hello wo");
+    EXPECT_EQ(body.Read(buffer.data(), buffer.size()), 4);
+    EXPECT_EQ(std::string_view(buffer.data(), 4), "rld!");
+    EXPECT_EQ(body.Read(buffer.data(), buffer.size()), 0);
+    EXPECT_FALSE(body.HasError());
+
+    // Copies share the file handle
+    const FileBody copy{body};
+    EXPECT_TRUE(copy.Seek(6));
+    EXPECT_EQ(body.Read(buffer.data(), buffer.size()), 6);
+    EXPECT_EQ(std::string_view(buffer.data(), 6), "world!");
+    std::remove(filename.c_str());
+}
+
+TEST(FileSinkTests, WriteTest) {
+    const std::string filename{"structures_file_sink"};
+    {
+        FileSink sink{filename, 8};
+        EXPECT_EQ(sink.GetPath(), filename);
+        EXPECT_EQ(sink.Write("Hello"), 5);
+        // Exceeds the buffer, so the buffer gets filled up and written first
+        EXPECT_EQ(sink.Write(" world"), 6);
+        // Fills up the buffer, a whole buffer gets written directly and the rest gets buffered
+        EXPECT_EQ(sink.Write(" from a file sink"), 17);
+        EXPECT_EQ(sink.Write("!"), 1);
+        // Only whole buffers have been written so far
+        EXPECT_EQ(std::ifstream(filename, std::ios::ate | std::ios::binary).tellg(), 24);
+        EXPECT_EQ(sink.GetSize(), 29);
+        EXPECT_EQ(sink.GetString(), "Hello world from a file sink!");
+        sink.Reserve(1024);
+        EXPECT_TRUE(sink.Flush());
+
+        std::string content;
+        std::getline(std::ifstream{filename}, content);
+        EXPECT_EQ(content, "Hello world from a file sink!");
+
+        sink.Clear();
+        EXPECT_EQ(sink.GetSize(), 0);
+        EXPECT_EQ(sink.GetString(), "");
+        EXPECT_EQ(sink.Write("Bye"), 3);
+    }
+    // Remaining data gets written on destruction
+    std::string content;
+    std::getline(std::ifstream{filename}, content);
+    EXPECT_EQ(content, "Bye");
+    std::remove(filename.c_str());
+}
+
+TEST(FileSinkTests, WriteAtTest) {
+    const std::string filename{"structures_file_sink_at"};
+    FileSink sink{filename};
+    EXPECT_EQ(sink.WriteAt(6, "world"), 5);
+    EXPECT_EQ(sink.WriteAt(0, "Hello "), 6);
+    EXPECT_EQ(sink.GetSize(), 11);
+    EXPECT_EQ(sink.GetString(), "Hello world");
+    EXPECT_EQ(sink.WriteAt(-1, "x"), 0);
+    std::remove(filename.c_str());
+}
+
+TEST(FileSinkTests, AppendTest) {
+    const std::string filename{"structures_file_sink_append"};
+    std::ofstream{filename} << "Hello";
+    FileSink sink{filename, FileSink::DEFAULT_BUFFER_SIZE, false, true};
+    EXPECT_EQ(sink.GetSize(), 5);
+    EXPECT_EQ(sink.Write(" world"), 6);
+    EXPECT_EQ(sink.GetString(), "Hello world");
+    // Only discards what got appended
+    sink.Clear();
+    EXPECT_EQ(sink.GetString(), "Hello");
+    std::remove(filename.c_str());
+}
+
+TEST(FileSinkTests, InvalidTest) {
+    EXPECT_THROW(FileSink("structures_file_sink_invalid", 0), std::invalid_argument);
+    try {
+        FileSink sink{"non/existing/directory/file"};
+        ADD_FAILURE() << "Expected std::system_error";
+    } catch (const std::system_error& e) {
+        EXPECT_EQ(e.code(), std::errc::no_such_file_or_directory);
+    }
+}
+
+TEST(DownloadCheckpointTests, SaveLoadTest) {
+    const std::string filename{"structures_download_checkpoint"};
+    DownloadCheckpoint checkpoint;
+    checkpoint.etag = "\"abc\"";
+    checkpoint.last_modified = "Wed, 21 Oct 2015 07:28:00 GMT";
+    checkpoint.ranges = {{100, 199}, {0, 99}, {300, 399}};
+    ASSERT_TRUE(checkpoint.Save(filename));
+
+    const std::optional<DownloadCheckpoint> loaded = DownloadCheckpoint::Load(filename);
+    ASSERT_TRUE(loaded);
+    EXPECT_EQ(loaded->etag, checkpoint.etag);
+    EXPECT_EQ(loaded->last_modified, checkpoint.last_modified);
+    EXPECT_EQ(loaded->ranges, checkpoint.ranges);
+    // The gap at 200 ends the completed prefix
+    EXPECT_EQ(loaded->GetCompletedPrefix(), 200);
+    EXPECT_EQ(loaded->GetValidator(), "\"abc\"");
+    std::remove(filename.c_str());
+
+    EXPECT_FALSE(DownloadCheckpoint::Load(filename));
+}
+
+TEST(DownloadCheckpointTests, ValidatorTest) {
+    DownloadCheckpoint checkpoint;
+    EXPECT_EQ(checkpoint.GetValidator(), "");
+    EXPECT_EQ(checkpoint.GetCompletedPrefix(), 0);
+    // Weak ETags can not be used for range requests
+    checkpoint.etag = "W/\"abc\"";
+    EXPECT_EQ(checkpoint.GetValidator(), "");
+    checkpoint.last_modified = "Wed, 21 Oct 2015 07:28:00 GMT";
+    EXPECT_EQ(checkpoint.GetValidator(), "Wed, 21 Oct 2015 07:28:00 GMT");
+}
+
+std::string compressStream(const RequestCompression& compression, const std::string& data) {
+    size_t offset = 0;
+    util::CompressionStream stream{compression,
+                                   [&data, &offset](char* buffer, size_t& size) {
+                                       // Hand out small pieces, so the data gets compressed incrementally
+                                       size = std::min<size_t>({size, 1000, data.size() - offset});
+                                       std::copy_n(data.data() + offset, size, buffer);
+                                       offset += size;
+                                       return true;
+                                   },
+                                   [&offset]() {
+                                       offset = 0;
+                                       return true;
+                                   }};
+    std::string result;
+    std::array<char, 512> buffer{};
+    size_t read = 0;
+    while ((read = stream.Read(buffer.data(), buffer.size())) > 0) {
+        result.append(buffer.data(), read);
+    }
+    // Starts over and produces the same data again
+    EXPECT_TRUE(stream.Rewind());
+    std::string repeated;
+    while ((read = stream.Read(buffer.data(), buffer.size())) > 0) {
+        repeated.append(buffer.data(), read);
+    }
+    EXPECT_EQ(result, repeated);
+    return result;
+}
+
+TEST(RequestCompressionTests, GzipTest) {
+    if (!RequestCompression::IsSupported(RequestCompressionMethod::gzip)) {
+        GTEST_SKIP() << "Built without zlib";
+    }
+    std::string data;
+    for (size_t i = 0; i < 10000; i++) {
+        data += "{\"id\": " + std::to_string(i) + ", \"name\": \"cpr\"}\n";
+    }
+    const RequestCompression compression{RequestCompressionMethod::gzip};
+    EXPECT_STREQ(compression.GetContentEncoding(), "gzip");
+    const std::string compressed = util::Compressor::CompressAll(compression, data);
+    EXPECT_EQ(compressed.substr(0, 2), "\x1f\x8b");
+    EXPECT_LT(compressed.size(), data.size() / 4);
+    EXPECT_EQ(compressStream(compression, data), compressed);
+}
+
+TEST(RequestCompressionTests, ZstdTest) {
+    if (!RequestCompression::IsSupported(RequestCompressionMethod::zstd)) {
+        GTEST_SKIP() << "Built without zstd";
+    }
+    std::string data;
+    for (size_t i = 0; i < 10000; i++) {
+        data += "{\"id\": " + std::to_string(i) + ", \"name\": \"cpr\"}\n";
+    }
+    const RequestCompression compression{RequestCompressionMethod::zstd, 1};
+    EXPECT_STREQ(compression.GetContentEncoding(), "zstd");
+    const std::string compressed = util::Compressor::CompressAll(compression, data);
+    EXPECT_EQ(compressed.substr(0, 4), "\x28\xb5\x2f\xfd");
+    EXPECT_LT(compressed.size(), data.size() / 4);
+    EXPECT_FALSE(compressStream(compression, data).empty());
+}
+
+TEST(RequestCompressionTests, InvalidTest) {
+    EXPECT_THROW(util::Compressor{RequestCompression{RequestCompressionMethod::identity}}, std::invalid_argument);
+    if (RequestCompression::IsSupported(RequestCompressionMethod::gzip)) {
+        // gzip has no dictionaries
+        EXPECT_THROW(util::Compressor(RequestCompression{RequestCompressionMethod::gzip, std::nullopt, "dictionary"}), std::invalid_argument);
+        EXPECT_THROW(util::Compressor(RequestCompression{RequestCompressionMethod::gzip, 42}), std::invalid_argument);
+    }
+}
+
+std::string decodeContent(std::string_view encoding, std::string_view data, size_t piece_size) {
+    std::string result;
+    util::ContentDecoder decoder{encoding, [&result](char* buffer, size_t size) {
+                                     result.append(buffer, size);
+                                     return size;
+                                 }};
+    while (!data.empty()) {
+        const std::string_view piece = data.substr(0, piece_size);
+        EXPECT_EQ(decoder.Write(piece), piece.size());
+        data.remove_prefix(piece.size());
+    }
+    return result;
+}
+
+TEST(ContentDecoderTests, GzipTest) {
+    if (!RequestCompression::IsSupported(RequestCompressionMethod::gzip)) {
+        GTEST_SKIP() << "Built without zlib";
+    }
+    std::string data;
+    for (size_t i = 0; i < 10000; i++) {
+        data += "cpr " + std::to_string(i) + "\n";
+    }
+    const std::string compressed = util::Compressor::CompressAll(RequestCompression{}, data);
+    EXPECT_TRUE(util::ContentDecoder::IsSupported("gzip"));
+    EXPECT_EQ(decodeContent("gzip", compressed, compressed.size()), data);
+    // Decoding works the same when the data arrives in small pieces
+    EXPECT_EQ(decodeContent(" GZIP ", compressed, 7), data);
+}
+
+TEST(ContentDecoderTests, ZstdTest) {
+    if (!RequestCompression::IsSupported(RequestCompressionMethod::zstd)) {
+        GTEST_SKIP() << "Built without zstd";
+    }
+    const std::string data(100000, 'a');
+    const std::string compressed = util::Compressor::CompressAll(RequestCompression{RequestCompressionMethod::zstd}, data);
+    EXPECT_EQ(decodeContent("zstd", compressed, 3), data);
+}
+
+TEST(ContentDecoderTests, BrotliTest) {
+    if (!util::ContentDecoder::IsSupported("br")) {
+        GTEST_SKIP() << "Built without brotli";
+    }
+    // 50000 times 'a'
+    const std::string compressed{"\x1b\x4f\xc3\x00\x24\xc2\xe2\xb1\x40\x12\x76\x01\x00", 13};
+    EXPECT_EQ(decodeContent("br", compressed, compressed.size()), std::string(50000, 'a'));
+    EXPECT_EQ(decodeContent("br", compressed, 1), std::string(50000, 'a'));
+}
+
+TEST(ContentDecoderTests, InvalidTest) {
+    EXPECT_TRUE(util::ContentDecoder::IsSupported("identity"));
+    EXPECT_FALSE(util::ContentDecoder::IsSupported("compress"));
+    EXPECT_THROW(util::ContentDecoder("compress", [](char* /*data*/, size_t size) { return size; }), std::invalid_argument);
+    if (util::ContentDecoder::IsSupported("gzip")) {
+        util::ContentDecoder decoder{"gzip", [](char* /*data*/, size_t size) { return size; }};
+        EXPECT_EQ(decoder.Write("not gzip data"), 0);
+    }
+}
+
+TEST(RequestArenaTests, ReleaseTest) {
+    RequestArena arena{1024};
+    // Copies share the same buffer
+    const RequestArena copy{arena};
+    EXPECT_EQ(arena.GetResource(), copy.GetResource());
+
+    std::pmr::string first{std::string(100, 'x'), arena.GetResource()};
+    const char* data = first.data();
+    std::pmr::string second{std::string(100, 'y'), arena.GetResource()};
+    EXPECT_NE(data, second.data());
+
+    // Exceeding the initial buffer falls back to the heap
+    std::pmr::string large{std::string(4096, 'z'), arena.GetResource()};
+    EXPECT_EQ(std::string_view{large}, std::string(4096, 'z'));
+
+    first = std::pmr::string{};
+    second = std::pmr::string{};
+    large = std::pmr::string{};
+    copy.Release();
+    // After releasing, allocations start at the beginning of the buffer again
+    std::pmr::string reused{std::string(100, 'x'), arena.GetResource()};
+    EXPECT_EQ(data, reused.data());
+}
+
+TEST(ResponseSinkTests, BufferSinkTest) {
+    std::array<char, 8> buffer{};
+    BufferSink sink{buffer.data(), buffer.size()};
+    EXPECT_EQ(sink.Write("Hello"), 5);
+    EXPECT_EQ(sink.GetView(), "Hello");
+    EXPECT_FALSE(sink.IsOverflown());
+    EXPECT_EQ(sink.Write(" world!"), 3);
+    EXPECT_TRUE(sink.IsOverflown());
+    EXPECT_EQ(sink.GetString(), "Hello wo");
+    sink.Clear();
+    EXPECT_EQ(sink.GetSize(), 0);
+    EXPECT_FALSE(sink.IsOverflown());
+}
+
+TEST(ResponseSinkTests, ChunkedSinkTest) {
+    ChunkedSink sink{4};
+    sink.Reserve(10);
+    EXPECT_EQ(sink.Write("Hello"), 5);
+    EXPECT_EQ(sink.Write(" world!"), 7);
+    EXPECT_EQ(sink.GetSize(), 12);
+    EXPECT_EQ(sink.GetString(), "Hello world!");
+    std::vector<std::string_view> expected_chunks{"Hell", "o wo", "rld!"};
+    EXPECT_EQ(sink.GetChunks(), expected_chunks);
+    sink.Clear();
+    EXPECT_EQ(sink.GetSize(), 0);
+    EXPECT_TRUE(sink.GetChunks().empty());
+    sink.Write("abc");
+    EXPECT_EQ(sink.GetString(), "abc");
+}
+
+TEST(ResponseSinkTests, ChunkedSinkZeroChunkSizeTest) {
+    EXPECT_THROW(ChunkedSink{0}, std::invalid_argument);
+}
+
+TEST(ResponseSinkTests, PmrSinkTest) {
+    std::array<std::byte, 256> arena{};
+    std::pmr::monotonic_buffer_resource resource{arena.data(), arena.size()};
+    PmrSink sink{&resource};
+    sink.Write("Hello ");
+    sink.Write("world!");
+    EXPECT_EQ(sink.GetBody(), "Hello world!");
+    EXPECT_EQ(sink.GetBody().get_allocator().resource(), &resource);
+}
+
+TEST(ResponseTests, ConstructorDefaultsTest) {
+    std::shared_ptr<CurlHolder> curl = std::make_shared<CurlHolder>();
+    // Constructing a response without a field mask loads all fields, like before the mask got introduced
+    Response response{curl, std::string{"text"}, std::string{"HTTP/1.1 200 OK\r\nServer: nginx\r\n\r\n"}, Cookies{}, Error{}};
+    EXPECT_EQ(ResponseFields::ALL, response.GetLoadedFields());
+    EXPECT_EQ(std::string{"nginx"}, response.header["Server"]);
+
+    Response minimal{curl, std::string{}, std::string{}};
+    EXPECT_EQ(ResponseFields::ALL, minimal.GetLoadedFields());
+    EXPECT_TRUE(minimal.header.empty());
+}
+
 int main(int argc, char** argv) {
     ::testing::InitGoogleTest(&argc, argv);
     return RUN_ALL_TESTS();
@@ -1,6 +1,7 @@
 #include <atomic>
 #include <cstddef>
 #include <gtest/gtest.h>
+#include <utility>
 
 
 #include "cpr/threadpool.h"
@@ -99,6 +100,46 @@ TEST(ThreadPoolTests, DISABLED_PauseResumeMultipleThreads) {
     }
 }
 
+// Counts how often it got copied, so forwarding of task arguments can be verified
+struct CopyCounter {
+    explicit CopyCounter(std::atomic_size_t* p_copies) : copies(p_copies) {}
+    CopyCounter(const CopyCounter& other) : copies(other.copies) {
+        (*copies)++;
+    }
+    CopyCounter(CopyCounter&& old) noexcept = default;
+    ~CopyCounter() = default;
+    CopyCounter& operator=(const CopyCounter& other) {
+        copies = other.copies;
+        (*copies)++;
+        return *this;
+    }
+    CopyCounter& operator=(CopyCounter&& old) noexcept = default;
+
+    std::atomic_size_t* copies;
+};
+
+TEST(ThreadPoolTests, SubmitForwardsArgumentsTest) {
+    std::atomic_size_t copies{0};
+    cpr::ThreadPool tp;
+    tp.SetMinThreadNum(1);
+    tp.SetMaxThreadNum(1);
+    tp.Start(0);
+
+    // Rvalues get moved all the way into the task
+    std::future<size_t> future = tp.Submit([](CopyCounter counter) { return counter.copies->load(); }, CopyCounter{&copies});
+    EXPECT_EQ(0, future.get());
+
+    // Lvalues get copied exactly once
+    CopyCounter counter{&copies};
+    future = tp.Submit([](CopyCounter&& inner) { return inner.copies->load(); }, counter);
+    EXPECT_EQ(1, future.get());
+
+    // Functions taking lvalue references get the stored copy
+    future = tp.Submit([](CopyCounter& inner) { return inner.copies->load(); }, counter);
+    EXPECT_EQ(2, future.get());
+    tp.Stop();
+}
+
 
 int main(int argc, char** argv) {
     ::testing::InitGoogleTest(&argc, argv);
@@ -1,8 +1,18 @@
 #include <gtest/gtest.h>
 
+#include <cstddef>
+#include <memory>
+#include <optional>
+#include <random>
+#include <stdexcept>
 #include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
 
 #include "cpr/cprtypes.h"
+#include "cpr/header_scanner.h"
+#include "cpr/response_header.h"
 #include "cpr/util.h"
 
 using namespace cpr;
@@ -30,6 +40,26 @@ TEST(UtilParseCookiesTests, BasicParseTest) {
     delete raw_cookies;
 }
 
+TEST(UtilParseCookiesTests, LazyParseTest) {
+    curl_slist* raw_cookies = curl_slist_append(nullptr, "127.0.0.1\tFALSE\t/\tFALSE\t1656908640\tstatus\ton");
+    raw_cookies = curl_slist_append(raw_cookies, "127.0.0.1\tFALSE\t/\tFALSE\t0\tname\tdebug");
+    const Cookies cookies{std::shared_ptr<curl_slist>(raw_cookies, curl_slist_free_all)};
+    // Copies taken before the first access share the unparsed list
+    const Cookies copy{cookies};
+    for (const Cookies& current : {cookies, copy}) {
+        ASSERT_FALSE(current.empty());
+        std::vector<std::string> names;
+        for (const Cookie& cookie : current) {
+            names.push_back(cookie.GetName());
+        }
+        EXPECT_EQ(names, (std::vector<std::string>{"status", "name"}));
+    }
+    Cookies moved{Cookies{std::shared_ptr<curl_slist>(nullptr, curl_slist_free_all)}};
+    EXPECT_TRUE(moved.empty());
+    moved = copy;
+    EXPECT_EQ(moved[1].GetValue(), "debug");
+}
+
 TEST(UtilParseHeaderTests, BasicParseTest) {
     std::string header_string{
             "HTTP/1.1 200 OK\r\n"
@@ -155,6 +185,240 @@ TEST(UtilParseHeaderTests, NoReasonTest) {
     EXPECT_EQ(std::string{"application/json"}, header["Content-Type"]);
 }
 
+TEST(ResponseHeaderTests, BasicTest) {
+    const std::string raw{
+            "HTTP/1.1 200 OK\r\n"
+            "Server: nginx\r\n"
+            "Content-Type:application/json \r\n"
+            "Set-Cookie: a=1\r\n"
+            "set-cookie: b=2\r\n"
+            "Empty:\r\n"
+            "\r\n"};
+    ResponseHeader header{raw};
+    EXPECT_EQ(header.size(), 4);
+    EXPECT_FALSE(header.empty());
+    EXPECT_EQ(header["server"], "nginx");
+    EXPECT_EQ(header["CONTENT-TYPE"], "application/json");
+    EXPECT_EQ(header["Set-Cookie"], "b=2");
+    EXPECT_EQ(header["Empty"], "");
+    EXPECT_EQ(header.count("Empty"), 1);
+    EXPECT_EQ(header["Missing"], "");
+    EXPECT_EQ(header.count("Missing"), 0);
+    EXPECT_TRUE(header.find("Missing") == header.end());
+    EXPECT_EQ(header.find("server")->first, "Server");
+    EXPECT_EQ(header.at("Server"), "nginx");
+    EXPECT_THROW(static_cast<void>(header.at("Missing")), std::out_of_range);
+
+    std::vector<std::pair<std::string_view, std::string_view>> expected{{"Server", "nginx"}, {"Content-Type", "application/json"}, {"Set-Cookie", "b=2"}, {"Empty", ""}};
+    std::vector<std::pair<std::string_view, std::string_view>> fields(header.begin(), header.end());
+    EXPECT_EQ(fields, expected);
+    // Values point into the raw block instead of being copied
+    EXPECT_EQ(header["Server"].data(), raw.data() + raw.find("nginx"));
+}
+
+TEST(ResponseHeaderTests, RedirectTest) {
+    const std::string raw{
+            "HTTP/1.1 302 Found\r\n"
+            "Location: /hello.html\r\n"
+            "\r\n"
+            "HTTP/1.1 200 OK\r\n"
+            "Server: nginx\r\n"
+            "\r\n"};
+    ResponseHeader header{raw};
+    EXPECT_EQ(header.size(), 1);
+    EXPECT_EQ(header.count("Location"), 0);
+    EXPECT_EQ(header["Server"], "nginx");
+}
+
+TEST(ResponseHeaderTests, CopyMoveTest) {
+    const std::string raw{"A: 1\r\n"};
+    ResponseHeader header{raw};
+    EXPECT_EQ(header["A"], "1");
+    ResponseHeader copy{header};
+    EXPECT_EQ(copy["a"], "1");
+    ResponseHeader moved{std::move(header)};
+    EXPECT_EQ(moved["a"], "1");
+    ResponseHeader assigned;
+    EXPECT_TRUE(assigned.empty());
+    assigned = std::move(moved);
+    EXPECT_EQ(assigned["A"], "1");
+    assigned = copy;
+    EXPECT_EQ(assigned["A"], "1");
+}
+
+TEST(ResponseHeaderTests, HeaderConversionTest) {
+    const std::string raw{"Server: nginx\r\nContent-Type: text/html\r\n"};
+    ResponseHeader response_header{raw};
+    Header converted = response_header;
+    Header expected{{"Server", "nginx"}, {"Content-Type", "text/html"}};
+    EXPECT_EQ(converted, expected);
+}
+
+TEST(ResponseHeaderTests, ParseHeaderEquivalenceTest) {
+    std::string header_string{
+            "HTTP/1.1 200 OK\r\n"
+            "Server: nginx\r\n"
+            "Date: Sun, 05 Mar 2017 00:34:54 GMT\r\n"
+            "Content-Type: application/json\r\n"
+            "Content-Length: 351\r\n"
+            "Connection: keep-alive\r\n"
+            "Access-Control-Allow-Origin: *\r\n"
+            "Access-Control-Allow-Credentials: true\r\n"
+            "\r\n"};
+    Header expected = util::parseHeader(header_string);
+    Header header = ResponseHeader{header_string};
+    EXPECT_EQ(header, expected);
+}
+
+TEST(HeaderScannerTests, BasicTest) {
+    const std::string data{"Content-Type: text/html\r\nDate: 00:34:54\r\nno colon\n\nLast:1"};
+    std::vector<util::HeaderLine> lines;
+    util::scanHeaderLines(data, lines);
+    const std::vector<util::HeaderLine> expected{{0, 12, 24}, {25, 29, 40}, {41, std::string_view::npos, 49}, {50, std::string_view::npos, 50}, {51, 55, 57}};
+    EXPECT_EQ(lines, expected);
+
+    lines.clear();
+    util::scanHeaderLines("", lines);
+    EXPECT_TRUE(lines.empty());
+}
+
+// Compares util::scanHeaderLines against a naive line and colon split on random header blocks
+TEST(HeaderScannerTests, DifferentialFuzzTest) {
+    const auto naiveScan = [](std::string_view data) {
+        std::vector<util::HeaderLine> lines;
+        size_t start = 0;
+        while (start < data.size()) {
+            size_t end = start;
+            while (end < data.size() && data[end] != '\n') {
+                end++;
+            }
+            size_t colon = std::string_view::npos;
+            for (size_t i = start; i < end; i++) {
+                if (data[i] == ':') {
+                    colon = i;
+                    break;
+                }
+            }
+            lines.push_back(util::HeaderLine{start, colon, end});
+            start = end + 1;
+        }
+        return lines;
+    };
+
+    std::mt19937 generator{4711};
+    std::uniform_int_distribution<size_t> percent{0, 99};
+    // Mostly short lines, some of them consisting of a CR only or lacking a colon
+    const std::string alphabet{"ab-:\r\n\n "};
+    std::uniform_int_distribution<size_t> character{0, alphabet.size() - 1};
+    for (size_t iteration = 0; iteration < 5000; iteration++) {
+        std::string data;
+        const size_t size = percent(generator);
+        for (size_t i = 0; i < size; i++) {
+            if (percent(generator) < 5) {
+                data += "\r\n";
+            } else {
+                data += alphabet[character(generator)];
+            }
+        }
+        // Blocks ending in the middle of a line are part of the input as well
+        if (percent(generator) < 50) {
+            data += "\r\n";
+        }
+
+        std::vector<util::HeaderLine> lines;
+        util::scanHeaderLines(data, lines);
+        ASSERT_EQ(lines, naiveScan(data)) << "Input: '" << data << "'";
+    }
+
+    // Explicit corner cases
+    for (const std::string_view data : {"\r", "\r\n\r\n", "\n\n", "no colon", "no colon\r\n", "a:b", ":", "a:\r", "x\ra:b\n"}) {
+        std::vector<util::HeaderLine> lines;
+        util::scanHeaderLines(data, lines);
+        EXPECT_EQ(lines, naiveScan(data)) << "Input: '" << data << "'";
+    }
+}
+
+// Compares the lazy ResponseHeader against util::parseHeader on random header blocks
+TEST(ResponseHeaderTests, DifferentialFuzzTest) {
+    std::mt19937 generator{1337};
+    std::uniform_int_distribution<size_t> percent{0, 99};
+    const std::string name_alphabet{"aAbBcC-_ "};
+    const std::string value_alphabet{"xyz:, \t\r"};
+    for (size_t iteration = 0; iteration < 2000; iteration++) {
+        std::string raw;
+        const size_t lines = percent(generator) % 40;
+        for (size_t line = 0; line < lines; line++) {
+            if (percent(generator) < 5) {
+                raw += "HTTP/1.1 200 OK";
+            } else if (percent(generator) < 5) {
+                raw += "no colon in this line";
+            } else {
+                const size_t name_length = percent(generator) % 4;
+                for (size_t i = 0; i < name_length; i++) {
+                    raw += name_alphabet[percent(generator) % name_alphabet.size()];
+                }
+                raw += ':';
+                const size_t value_length = percent(generator) % 40;
+                for (size_t i = 0; i < value_length; i++) {
+                    raw += value_alphabet[percent(generator) % value_alphabet.size()];
+                }
+            }
+            raw += percent(generator) < 50 ? "\r\n" : "\n";
+        }
+        const Header expected = util::parseHeader(raw);
+        const Header header = ResponseHeader{raw};
+        EXPECT_EQ(header, expected) << "Raw header: '" << raw << "'";
+    }
+}
+
+TEST(UtilParseContentLengthTests, BasicParseTest) {
+    EXPECT_EQ(util::parseContentLength("Content-Length: 1234\r\n"), std::optional<size_t>{1234});
+    EXPECT_EQ(util::parseContentLength("content-length:\t0\r\n"), std::optional<size_t>{0});
+    EXPECT_EQ(util::parseContentLength("CONTENT-LENGTH:42"), std::optional<size_t>{42});
+    EXPECT_EQ(util::parseContentLength("Content-Length: 7 \t\r\n"), std::optional<size_t>{7});
+}
+
+TEST(UtilParseContentLengthTests, InvalidTest) {
+    EXPECT_FALSE(util::parseContentLength("Content-Type: text/html\r\n"));
+    EXPECT_FALSE(util::parseContentLength("Content-Length: abc\r\n"));
+    EXPECT_FALSE(util::parseContentLength("Content-Length: -1\r\n"));
+    EXPECT_FALSE(util::parseContentLength("Content-Length: 99999999999999999999999999\r\n"));
+    EXPECT_FALSE(util::parseContentLength("Content-Len"));
+    EXPECT_FALSE(util::parseContentLength("Content-Length: 12abc\r\n"));
+    EXPECT_FALSE(util::parseContentLength("Content-Length: 12, 12\r\n"));
+    EXPECT_FALSE(util::parseContentLength("Content-Length: 1 2\r\n"));
+    EXPECT_FALSE(util::parseContentLength("Content-Length: \r\n"));
+    EXPECT_FALSE(util::parseContentLength(""));
+}
+
+TEST(UtilParseContentRangeTests, BasicParseTest) {
+    using Positions = std::optional<std::pair<cpr_off_t, cpr_off_t>>;
+    EXPECT_EQ(util::parseContentRange("Content-Range: bytes 0-99/1000\r\n"), (Positions{{0, 99}}));
+    EXPECT_EQ(util::parseContentRange("content-range:bytes 500-999/*"), (Positions{{500, 999}}));
+}
+
+TEST(UtilParseContentRangeTests, InvalidTest) {
+    EXPECT_FALSE(util::parseContentRange("Content-Length: 100\r\n"));
+    EXPECT_FALSE(util::parseContentRange("Content-Range: bytes */1000\r\n"));
+    EXPECT_FALSE(util::parseContentRange("Content-Range: items 0-99/1000\r\n"));
+    EXPECT_FALSE(util::parseContentRange("Content-Range: bytes 99-0/1000\r\n"));
+    EXPECT_FALSE(util::parseContentRange("Content-Range: bytes 0-99\r\n"));
+    EXPECT_FALSE(util::parseContentRange("Content-Range: bytes -1-99/1000\r\n"));
+    EXPECT_FALSE(util::parseContentRange("Content-Range: bytes 0x0-99/1000\r\n"));
+    EXPECT_FALSE(util::parseContentRange("Content-Ranges: bytes 0-99/1000\r\n"));
+}
+
+TEST(UtilWriteHeaderReserveTests, CapTest) {
+    std::string header;
+    std::string body;
+    util::ContentLengthReserve data{&header, &body, nullptr, 1024};
+    std::string line{"Content-Length: 100000\r\n"};
+    EXPECT_EQ(util::writeHeaderReserveFunction(line.data(), 1, line.size(), &data), line.size());
+    EXPECT_EQ(header, line);
+    EXPECT_GE(body.capacity(), 1024);
+    EXPECT_LT(body.capacity(), 100000);
+}
+
 TEST(UtilUrlEncodeTests, UnicodeEncoderTest) {
     std::string input = "一二三";
     std::string result{util::urlEncode(input)};
@@ -183,6 +447,56 @@ TEST(UtilUrlDecodeTests, AsciiDecoderTest) {
     EXPECT_EQ(result, expected);
 }
 
+TEST(UtilUrlEncodeTests, CurlEquivalenceTest) {
+    // All byte values, repeated with different offsets to cover the vectorized and the remaining part
+    std::string input;
+    for (size_t i = 0; i < 3 * 256 + 7; i++) {
+        input += static_cast<char>(i % 256);
+    }
+    input += std::string(100, 'a') + "~-._/" + std::string(33, 'Z');
+    CURL* handle = curl_easy_init();
+    char* encoded = curl_easy_escape(handle, input.data(), static_cast<int>(input.size()));
+    EXPECT_EQ(util::urlEncode(input), std::string{encoded});
+    EXPECT_EQ(util::urlEncodedSize(input), std::string{encoded}.size());
+    int decoded_size = 0;
+    char* decoded = curl_easy_unescape(handle, encoded, 0, &decoded_size);
+    EXPECT_EQ(util::urlDecode(encoded), std::string(decoded, static_cast<size_t>(decoded_size)));
+    EXPECT_EQ(util::urlDecode(encoded), input);
+    curl_free(decoded);
+    curl_free(encoded);
+    curl_easy_cleanup(handle);
+}
+
+TEST(UtilUrlEncodeTests, BufferTest) {
+    const std::string input = "key=a b&c";
+    std::string output(util::urlEncodedSize(input), '\0');
+    EXPECT_EQ(util::urlEncode(input, output.data()), output.size());
+    EXPECT_EQ(output, "key%3Da%20b%26c");
+
+    std::string appended = "q=";
+    util::appendUrlEncoded(appended, input);
+    EXPECT_EQ(appended, "q=key%3Da%20b%26c");
+
+    std::string decoded(output.size(), '\0');
+    decoded.resize(util::urlDecode(output, decoded.data()));
+    EXPECT_EQ(decoded, input);
+}
+
+TEST(UtilUrlEncodeTests, SecureTest) {
+    const util::SecureString encoded = util::urlEncodeSecure("p@ss word");
+    EXPECT_EQ(encoded, "p%40ss%20word");
+    EXPECT_EQ(util::urlDecodeSecure(encoded), "p@ss word");
+}
+
+TEST(UtilUrlDecodeTests, InvalidEscapeTest) {
+    EXPECT_EQ(util::urlDecode("100%"), "100%");
+    EXPECT_EQ(util::urlDecode("%4"), "%4");
+    EXPECT_EQ(util::urlDecode("%zz%41%4a%4A+"), "%zzAJJ+");
+    EXPECT_EQ(util::urlDecode("a%00b"), std::string("a\0b", 3));
+    EXPECT_EQ(util::urlEncode(""), "");
+    EXPECT_EQ(util::urlDecode(""), "");
+}
+
 TEST(UtilIsTrueTests, TrueTest) {
     {
         std::string input = "TRUE";